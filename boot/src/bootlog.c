@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "bootlog.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/init.h>
+#include <zephyr/irq.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/retention/retention.h>
+#include <zephyr/sys/printk-hooks.h>
+
+#include <pb/bootbit.h>
+
+LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
+
+#define BOOTLOG_NODE DT_CHOSEN(pb_bootlog)
+
+/* retention area size, minus prefix and checksum */
+#define BOOTLOG_AREA_SIZE                                                                          \
+	(DT_REG_SIZE(BOOTLOG_NODE) - DT_PROP_LEN_OR(BOOTLOG_NODE, prefix, 0) -                     \
+	 DT_PROP_OR(BOOTLOG_NODE, checksum, 0))
+#define BOOTLOG_DATA_SIZE (BOOTLOG_AREA_SIZE - sizeof(struct pb_bootlog_header))
+
+struct bootlog {
+	struct pb_bootlog_header hdr;
+	uint8_t data[BOOTLOG_DATA_SIZE];
+};
+
+static const struct device *retention = DEVICE_DT_GET(BOOTLOG_NODE);
+static struct bootlog bootlog = {
+	.hdr = {
+		.version = PB_BOOTLOG_VERSION,
+		.size = BOOTLOG_DATA_SIZE,
+	},
+};
+
+/* console (UART) output, as installed before the boot log took over */
+static int (*console_out)(int c);
+static bool uart_enabled;
+
+static int bootlog_out(int c)
+{
+	unsigned int key;
+
+	/* output may come from several threads (e.g. boot tasks) */
+	key = irq_lock();
+	bootlog.data[bootlog.hdr.head % BOOTLOG_DATA_SIZE] = (uint8_t)c;
+	bootlog.hdr.head++;
+	irq_unlock(key);
+
+	if (uart_enabled) {
+		return console_out(c);
+	}
+
+	return c;
+}
+
+void pb_bootlog_init(void)
+{
+	uint32_t start;
+
+	if (console_out == NULL) {
+		return;
+	}
+
+	if (!IS_ENABLED(CONFIG_PB_BOOTLOG_UART) && !pb_bootbit_tst(PB_BOOTBIT_BOOTLOG_UART)) {
+		return;
+	}
+
+	/* replay output captured so far */
+	start = (bootlog.hdr.head > BOOTLOG_DATA_SIZE) ? (bootlog.hdr.head - BOOTLOG_DATA_SIZE)
+						       : 0U;
+	for (uint32_t i = start; i < bootlog.hdr.head; i++) {
+		(void)console_out(bootlog.data[i % BOOTLOG_DATA_SIZE]);
+	}
+
+	uart_enabled = true;
+}
+
+void pb_bootlog_commit(void)
+{
+	int ret;
+
+	if (!device_is_ready(retention)) {
+		return;
+	}
+
+	ret = retention_write(retention, 0U, (const uint8_t *)&bootlog, sizeof(bootlog));
+	if (ret < 0) {
+		LOG_ERR("Failed to write boot log (err %d)", ret);
+	}
+}
+
+static int bootlog_capture_init(void)
+{
+	/* take over console output, UART output is decided in pb_bootlog_init() */
+	console_out = __printk_get_hook();
+	__printk_hook_install(bootlog_out);
+
+	return 0;
+}
+
+SYS_INIT(bootlog_capture_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
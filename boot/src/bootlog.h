@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file bootlog.h
+ * @brief Deferred boot log for pblboot.
+ *
+ * All console output is captured in RAM and handed over to the firmware in
+ * retained memory, so that it can be collected with the rest of the
+ * diagnostics. Output only goes to the UART if enabled by
+ * @kconfig{CONFIG_PB_BOOTLOG_UART} or by the @ref PB_BOOTBIT_BOOTLOG_UART
+ * bootbit, keeping the (blocking) UART off the boot critical path.
+ *
+ * @see pb/bootlog.h for the boot log handed to the firmware.
+ */
+
+#ifndef BOOT_SRC_BOOTLOG_H_
+#define BOOT_SRC_BOOTLOG_H_
+
+#include <pb/bootlog.h>
+
+#ifdef CONFIG_PB_BOOTLOG
+
+/**
+ * @brief Initialize the boot log.
+ *
+ * Decides whether output goes to the UART too. If so, output captured so far
+ * is replayed to the UART. Bootbits must be initialized.
+ */
+void pb_bootlog_init(void);
+
+/**
+ * @brief Commit the boot log to retained memory.
+ *
+ * This must be called right before jumping to the firmware, and on panic.
+ */
+void pb_bootlog_commit(void);
+
+#else
+
+static inline void pb_bootlog_init(void)
+{
+}
+
+static inline void pb_bootlog_commit(void)
+{
+}
+
+#endif /* CONFIG_PB_BOOTLOG */
+
+#endif /* BOOT_SRC_BOOTLOG_H_ */
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "bootstate.h"
+#include "boottime.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/retention/retention.h>
+#include <zephyr/sys/util.h>
+
+#include <pb/bootbit.h>
+#include <pb/bootbit_backend.h>
+
+LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
+
+static const struct device *retention = DEVICE_DT_GET(DT_CHOSEN(pb_bootstate));
+static struct pb_bootstate state;
+static struct pb_bootstate_record record = {
+	.slot = PB_BOOTSTATE_SLOT_NONE,
+};
+/* boot bits word last written to the backend */
+static uint32_t stored;
+static uint32_t validation_time;
+static int load_err;
+static bool committed;
+
+static int bootstate_load(void)
+{
+	int ret;
+
+	if (!device_is_ready(retention)) {
+		return -ENODEV;
+	}
+
+	if (retention_size(retention) < sizeof(state)) {
+		return -ENOSPC;
+	}
+
+	if (retention_is_valid(retention) == 1) {
+		ret = retention_read(retention, 0U, (uint8_t *)&state, sizeof(state));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if ((state.version != PB_BOOTSTATE_VERSION) ||
+	    (state.history_head >= PB_BOOTSTATE_HISTORY_LEN)) {
+		memset(&state, 0, sizeof(state));
+		state.version = PB_BOOTSTATE_VERSION;
+	}
+
+	return 0;
+}
+
+static void bootstate_store(void)
+{
+	int ret;
+
+	/* the block is not kept if the retained area is not usable */
+	if (load_err < 0) {
+		return;
+	}
+
+	ret = retention_write(retention, 0U, (const uint8_t *)&state, sizeof(state));
+	if (ret < 0) {
+		LOG_ERR("Failed to write boot state (err %d)", ret);
+	}
+}
+
+void pb_bootbit_init(void)
+{
+	load_err = bootstate_load();
+	if (load_err < 0) {
+		memset(&state, 0, sizeof(state));
+	}
+
+	/* the firmware updates the boot bits storage, not the block */
+	state.bootbits = pb_bootbit_backend_load();
+	stored = state.bootbits;
+
+	if (!pb_bootbit_tst(PB_BOOTBIT_INITIALIZED)) {
+		state.bootbits = BIT(PB_BOOTBIT_INITIALIZED);
+		pb_bootbit_commit();
+	}
+}
+
+void pb_bootbit_set(enum pb_bootbit bit)
+{
+	state.bootbits |= BIT(bit);
+}
+
+void pb_bootbit_clr(enum pb_bootbit bit)
+{
+	state.bootbits &= ~BIT(bit);
+}
+
+bool pb_bootbit_tst(enum pb_bootbit bit)
+{
+	return (state.bootbits & BIT(bit)) != 0U;
+}
+
+void pb_bootbit_commit(void)
+{
+	if (state.bootbits == stored) {
+		return;
+	}
+
+	pb_bootbit_backend_store(state.bootbits);
+	stored = state.bootbits;
+
+	bootstate_store();
+}
+
+/* check if the last recorded boot detected a reset loop */
+static bool bootstate_reset_loop_last(void)
+{
+	uint16_t last;
+
+	if (state.boots == 0U) {
+		return false;
+	}
+
+	last = (state.history_head + PB_BOOTSTATE_HISTORY_LEN - 1U) % PB_BOOTSTATE_HISTORY_LEN;
+
+	return state.history[last].reason == PB_BOOTSTATE_REASON_RESET_LOOP;
+}
+
+int pb_bootstate_init(void)
+{
+	if (load_err < 0) {
+		return load_err;
+	}
+
+	/*
+	 * the firmware clears the reset loop boot bits once it is up; they are
+	 * also cleared when a reset loop is detected, but resets keep going
+	 */
+	if ((pb_bootbit_reset_loop_cnt_get() == 0U) && !bootstate_reset_loop_last()) {
+		state.reset_cnt = 0U;
+	}
+
+	if (state.reset_cnt < UINT16_MAX) {
+		state.reset_cnt++;
+	}
+
+	state.boots++;
+
+	record.seq = state.boots;
+	record.reset_cnt = state.reset_cnt;
+
+	return 0;
+}
+
+void pb_bootstate_reason(enum pb_bootstate_reason reason)
+{
+	record.reason = (uint8_t)reason;
+
+	switch (reason) {
+	case PB_BOOTSTATE_REASON_STABLE:
+		state.fw_fail_cnt = 0U;
+		state.prf_fail_cnt = 0U;
+		break;
+	case PB_BOOTSTATE_REASON_FW_FAIL:
+	case PB_BOOTSTATE_REASON_FW_STRIKES:
+		state.fw_fails++;
+		if (state.fw_fail_cnt < UINT16_MAX) {
+			state.fw_fail_cnt++;
+		}
+		break;
+	case PB_BOOTSTATE_REASON_PRF_FAIL:
+	case PB_BOOTSTATE_REASON_PRF_STRIKES:
+		state.prf_fails++;
+		if (state.prf_fail_cnt < UINT16_MAX) {
+			state.prf_fail_cnt++;
+		}
+		break;
+	case PB_BOOTSTATE_REASON_RESET_LOOP:
+		state.reset_loops++;
+		break;
+	default:
+		break;
+	}
+}
+
+void pb_bootstate_validation(uint32_t start)
+{
+	validation_time += pb_boottime_now() - start;
+}
+
+void pb_bootstate_slot(enum pb_bootstate_slot slot)
+{
+	record.slot = (uint8_t)slot;
+
+	if (slot == PB_BOOTSTATE_SLOT_PRF) {
+		state.prf_boots++;
+	}
+}
+
+void pb_bootstate_panic(uint32_t reason)
+{
+	record.panic = reason;
+	state.panics++;
+}
+
+void pb_bootstate_commit(void)
+{
+	if (committed || (load_err < 0)) {
+		return;
+	}
+
+	committed = true;
+
+	record.validation_us = pb_boottime_to_us(validation_time);
+
+	state.history[state.history_head] = record;
+	state.history_head = (state.history_head + 1U) % PB_BOOTSTATE_HISTORY_LEN;
+
+	bootstate_store();
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file bootstate.h
+ * @brief Retained boot state and boot history for pblboot.
+ *
+ * The boot state block is the bootloader copy of the boot state: the boot bits
+ * API (pb/bootbit.h) operates on the boot bits word kept in the block, and
+ * pb_bootbit_commit() stores it to the boot bits backend (e.g. RTC backup
+ * register), which remains the interface with the firmware, then writes the
+ * block. The backend is only read once, by pb_bootbit_init(), since the
+ * firmware updates it while running. The block also holds statistics and a
+ * history of the last boots, for field diagnostics.
+ *
+ * @see pb/bootstate.h for the block handed to the firmware.
+ */
+
+#ifndef BOOT_SRC_BOOTSTATE_H_
+#define BOOT_SRC_BOOTSTATE_H_
+
+#include <stdint.h>
+
+#include <pb/bootstate.h>
+
+#ifdef CONFIG_PB_BOOTSTATE
+
+/**
+ * @brief Initialize the boot state block.
+ *
+ * The block itself is loaded by pb_bootbit_init(), and reset if the retained
+ * memory contents are not valid. This starts the boot record, so the reset
+ * loop counter must not be updated yet.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int pb_bootstate_init(void);
+
+/**
+ * @brief Set the boot reason.
+ *
+ * Counters and statistics are updated accordingly.
+ *
+ * @param reason Boot reason.
+ */
+void pb_bootstate_reason(enum pb_bootstate_reason reason);
+
+/**
+ * @brief Record the duration of an image validation.
+ *
+ * Durations are only known with @kconfig{CONFIG_PB_BOOTTIME}.
+ *
+ * @param start Boot timing counter value when validation started.
+ */
+void pb_bootstate_validation(uint32_t start);
+
+/**
+ * @brief Set the image about to be booted.
+ *
+ * @param slot Image.
+ */
+void pb_bootstate_slot(enum pb_bootstate_slot slot);
+
+/**
+ * @brief Record a panic.
+ *
+ * @param reason Panic reason.
+ */
+void pb_bootstate_panic(uint32_t reason);
+
+/**
+ * @brief Commit the boot record and the block to retained memory.
+ *
+ * This must be called right before jumping to an image, and on panic. Only
+ * the first call has any effect.
+ */
+void pb_bootstate_commit(void);
+
+#else
+
+static inline int pb_bootstate_init(void)
+{
+	return 0;
+}
+
+static inline void pb_bootstate_reason(enum pb_bootstate_reason reason)
+{
+}
+
+static inline void pb_bootstate_validation(uint32_t start)
+{
+}
+
+static inline void pb_bootstate_slot(enum pb_bootstate_slot slot)
+{
+}
+
+static inline void pb_bootstate_panic(uint32_t reason)
+{
+}
+
+static inline void pb_bootstate_commit(void)
+{
+}
+
+#endif /* CONFIG_PB_BOOTSTATE */
+
+#endif /* BOOT_SRC_BOOTSTATE_H_ */
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "boottask.h"
+#include "boottime.h"
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/__assert.h>
+
+LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
+
+enum boottask_state {
+	BOOTTASK_IDLE,
+	BOOTTASK_SUBMITTED,
+	BOOTTASK_RUNNING,
+	BOOTTASK_DONE,
+};
+
+static sys_slist_t pending = SYS_SLIST_STATIC_INIT(&pending);
+
+#if CONFIG_PB_BOOTTASK_THREADS > 0
+static K_MUTEX_DEFINE(lock);
+static K_CONDVAR_DEFINE(changed);
+
+static inline void boottask_lock(void)
+{
+	(void)k_mutex_lock(&lock, K_FOREVER);
+}
+
+static inline void boottask_unlock(void)
+{
+	(void)k_mutex_unlock(&lock);
+}
+
+static inline void boottask_block(void)
+{
+	(void)k_condvar_wait(&changed, &lock, K_FOREVER);
+}
+
+static inline void boottask_notify(void)
+{
+	(void)k_condvar_broadcast(&changed);
+}
+#else
+static inline void boottask_lock(void)
+{
+}
+
+static inline void boottask_unlock(void)
+{
+}
+
+static inline void boottask_block(void)
+{
+	/* nothing else can complete the task */
+	__ASSERT_NO_MSG(false);
+}
+
+static inline void boottask_notify(void)
+{
+}
+#endif /* CONFIG_PB_BOOTTASK_THREADS > 0 */
+
+/* check if a submitted task can start, must be called with the lock held */
+static bool boottask_ready(const struct pb_boottask *task)
+{
+	if (task->state != BOOTTASK_SUBMITTED) {
+		return false;
+	}
+
+	for (size_t i = 0U; i < task->deps_count; i++) {
+		if (task->deps[i]->state != BOOTTASK_DONE) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* find a task ready to start among @p task and its dependencies */
+static struct pb_boottask *boottask_ready_find(struct pb_boottask *task)
+{
+	struct pb_boottask *ready;
+
+	if (boottask_ready(task)) {
+		return task;
+	}
+
+	for (size_t i = 0U; i < task->deps_count; i++) {
+		ready = boottask_ready_find(task->deps[i]);
+		if (ready != NULL) {
+			return ready;
+		}
+	}
+
+	return NULL;
+}
+
+/* run a ready task, must be called with the lock held */
+static void boottask_run(struct pb_boottask *task)
+{
+	int ret = 0;
+
+	task->state = BOOTTASK_RUNNING;
+	(void)sys_slist_find_and_remove(&pending, &task->node);
+
+	for (size_t i = 0U; i < task->deps_count; i++) {
+		if (task->deps[i]->ret < 0) {
+			ret = -ECANCELED;
+			break;
+		}
+	}
+
+	boottask_unlock();
+
+	task->start = pb_boottime_now();
+	if (ret == 0) {
+		ret = task->fn();
+	}
+	task->end = pb_boottime_now();
+
+	pb_boottime_task(task->name, task->start, task->end);
+
+	boottask_lock();
+
+	task->ret = ret;
+	task->state = BOOTTASK_DONE;
+
+	boottask_notify();
+}
+
+void pb_boottask_submit(struct pb_boottask *task)
+{
+	boottask_lock();
+
+	__ASSERT_NO_MSG(task->state == BOOTTASK_IDLE);
+
+	task->state = BOOTTASK_SUBMITTED;
+	sys_slist_append(&pending, &task->node);
+
+	boottask_notify();
+
+	boottask_unlock();
+}
+
+int pb_boottask_wait(struct pb_boottask *task)
+{
+	struct pb_boottask *ready;
+	int ret;
+
+	boottask_lock();
+
+	__ASSERT_NO_MSG(task->state != BOOTTASK_IDLE);
+
+	/* help with the task (or its dependencies) instead of just blocking */
+	while (task->state != BOOTTASK_DONE) {
+		ready = boottask_ready_find(task);
+		if (ready != NULL) {
+			boottask_run(ready);
+		} else {
+			boottask_block();
+		}
+	}
+
+	ret = task->ret;
+
+	boottask_unlock();
+
+	return ret;
+}
+
+bool pb_boottask_submitted(const struct pb_boottask *task)
+{
+	return task->state != BOOTTASK_IDLE;
+}
+
+#if CONFIG_PB_BOOTTASK_THREADS > 0
+static void boottask_worker(void *p1, void *p2, void *p3)
+{
+	struct pb_boottask *task;
+	struct pb_boottask *ready;
+
+	boottask_lock();
+
+	while (true) {
+		ready = NULL;
+		SYS_SLIST_FOR_EACH_CONTAINER(&pending, task, node) {
+			if (boottask_ready(task)) {
+				ready = task;
+				break;
+			}
+		}
+
+		if (ready != NULL) {
+			boottask_run(ready);
+		} else {
+			boottask_block();
+		}
+	}
+}
+
+#define BOOTTASK_WORKER_DEFINE(n, _)                                                               \
+	K_THREAD_DEFINE(boottask_worker##n, CONFIG_PB_BOOTTASK_STACK_SIZE, boottask_worker, NULL,  \
+			NULL, NULL, CONFIG_PB_BOOTTASK_PRIORITY, 0, 0);
+
+LISTIFY(CONFIG_PB_BOOTTASK_THREADS, BOOTTASK_WORKER_DEFINE, ())
+#endif /* CONFIG_PB_BOOTTASK_THREADS > 0 */
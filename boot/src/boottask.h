@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file boottask.h
+ * @brief Boot task scheduler for pblboot.
+ *
+ * Boot tasks are independent pieces of the boot sequence (e.g. peripheral
+ * initialization, slot validation) with explicit dependencies on other tasks.
+ * Submitted tasks run on a small pool of worker threads as soon as their
+ * dependencies are done (see @kconfig{CONFIG_PB_BOOTTASK_THREADS}), so that
+ * tasks waiting on different peripherals overlap. A thread waiting for a task
+ * also runs the pending tasks it depends on.
+ *
+ * Without worker threads, tasks run on the waiting thread, in dependency
+ * order, so the boot sequence is the same as calling them in order.
+ */
+
+#ifndef BOOT_SRC_BOOTTASK_H_
+#define BOOT_SRC_BOOTTASK_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/util.h>
+
+/** Boot task */
+struct pb_boottask {
+	/** Task name, used for timing logs */
+	const char *name;
+	/** Task function, returning 0 or a negative error code */
+	int (*fn)(void);
+	/** Tasks that must be done before this one runs */
+	struct pb_boottask *const *deps;
+	/** Number of dependencies */
+	size_t deps_count;
+
+	/* internal state */
+	sys_snode_t node;
+	uint8_t state;
+	int ret;
+	uint32_t start;
+	uint32_t end;
+};
+
+/**
+ * @brief Define a boot task.
+ *
+ * @param _name Task variable name.
+ * @param _fn Task function.
+ * @param ... Pointers to the tasks this task depends on, if any.
+ */
+#define PB_BOOTTASK_DEFINE(_name, _fn, ...)                                                        \
+	static struct pb_boottask *const _name##_deps[] = {__VA_ARGS__};                           \
+	static struct pb_boottask _name = {                                                        \
+		.name = #_name,                                                                    \
+		.fn = _fn,                                                                         \
+		.deps = _name##_deps,                                                              \
+		.deps_count = ARRAY_SIZE(_name##_deps),                                            \
+	}
+
+/**
+ * @brief Submit a boot task.
+ *
+ * The task runs once all its dependencies are done. If any dependency failed,
+ * the task is not run and fails with -ECANCELED. Dependencies must be
+ * submitted before (or together with) the task depending on them.
+ *
+ * @param task Task.
+ */
+void pb_boottask_submit(struct pb_boottask *task);
+
+/**
+ * @brief Wait for a boot task to be done.
+ *
+ * @param task Task, must have been submitted.
+ *
+ * @return Value returned by the task function, or -ECANCELED if a dependency
+ *         failed.
+ */
+int pb_boottask_wait(struct pb_boottask *task);
+
+/**
+ * @brief Check if a boot task has been submitted.
+ *
+ * @param task Task.
+ *
+ * @retval true if the task has been submitted
+ * @retval false otherwise
+ */
+bool pb_boottask_submitted(const struct pb_boottask *task);
+
+#endif /* BOOT_SRC_BOOTTASK_H_ */
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "boottime.h"
+
+#include <inttypes.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/retention/retention.h>
+#include <zephyr/timing/timing.h>
+
+LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
+
+static const struct device *retention = DEVICE_DT_GET(DT_CHOSEN(pb_boottime));
+static struct pb_boottime_record record;
+
+uint32_t pb_boottime_to_us(uint32_t ticks)
+{
+	return (uint32_t)(((uint64_t)ticks * USEC_PER_SEC) / record.freq);
+}
+
+#ifdef CONFIG_PB_BOOTTIME_LOG
+static void boottime_log(void)
+{
+	uint32_t prev = record.marks[PB_BOOTTIME_MARK_MAIN];
+	uint32_t phases[PB_BOOTTIME_MARK_COUNT] = {0};
+
+	/* duration of each phase since the previous reached mark */
+	for (uint8_t i = PB_BOOTTIME_MARK_BOOTBIT_INIT; i < PB_BOOTTIME_MARK_COUNT; i++) {
+		if (record.marks[i] != 0U) {
+			phases[i] = pb_boottime_to_us(record.marks[i] - prev);
+			prev = record.marks[i];
+		}
+	}
+
+	LOG_INF("boottime us: bb=%" PRIu32 " init=%" PRIu32 " chg=%" PRIu32 " st=%" PRIu32
+		" s0=%" PRIu32 " s1=%" PRIu32 " prf=%" PRIu32 " tot=%" PRIu32,
+		phases[PB_BOOTTIME_MARK_BOOTBIT_INIT], phases[PB_BOOTTIME_MARK_PERIPH_INIT],
+		phases[PB_BOOTTIME_MARK_CHARGER], phases[PB_BOOTTIME_MARK_BOOT_STATE],
+		pb_boottime_to_us(record.validations[PB_BOOTTIME_VALIDATION_SLOT0]),
+		pb_boottime_to_us(record.validations[PB_BOOTTIME_VALIDATION_SLOT1]),
+		pb_boottime_to_us(record.validations[PB_BOOTTIME_VALIDATION_PRF]),
+		pb_boottime_to_us(record.marks[PB_BOOTTIME_MARK_JUMP] -
+			       record.marks[PB_BOOTTIME_MARK_MAIN]));
+}
+#endif /* CONFIG_PB_BOOTTIME_LOG */
+
+void pb_boottime_init(void)
+{
+#ifdef CONFIG_TIMING_FUNCTIONS
+	timing_init();
+	timing_start();
+	record.freq = (uint32_t)timing_freq_get();
+#else
+	record.freq = sys_clock_hw_cycles_per_sec();
+#endif
+	record.version = PB_BOOTTIME_VERSION;
+
+	pb_boottime_mark(PB_BOOTTIME_MARK_MAIN);
+}
+
+uint32_t pb_boottime_now(void)
+{
+	uint32_t now;
+
+#ifdef CONFIG_TIMING_FUNCTIONS
+	now = (uint32_t)timing_counter_get();
+#else
+	now = k_cycle_get_32();
+#endif
+
+	/* 0 is reserved for marks not reached */
+	return (now != 0U) ? now : 1U;
+}
+
+void pb_boottime_mark(enum pb_boottime_mark mark)
+{
+	record.marks[mark] = pb_boottime_now();
+}
+
+void pb_boottime_validation(enum pb_boottime_validation validation, uint32_t start)
+{
+	record.validations[validation] = pb_boottime_now() - start;
+}
+
+void pb_boottime_task(const char *name, uint32_t start, uint32_t end)
+{
+#ifdef CONFIG_PB_BOOTTIME_LOG
+	uint32_t base = record.marks[PB_BOOTTIME_MARK_MAIN];
+
+	LOG_INF("boottime us: task %s start=%" PRIu32 " end=%" PRIu32, name,
+		pb_boottime_to_us(start - base), pb_boottime_to_us(end - base));
+#endif
+}
+
+void pb_boottime_commit(void)
+{
+	int ret;
+
+	pb_boottime_mark(PB_BOOTTIME_MARK_JUMP);
+
+#ifdef CONFIG_PB_BOOTTIME_LOG
+	boottime_log();
+#endif
+
+	if (!device_is_ready(retention)) {
+		return;
+	}
+
+	ret = retention_write(retention, 0U, (const uint8_t *)&record, sizeof(record));
+	if (ret < 0) {
+		LOG_ERR("Failed to write boot timing record (err %d)", ret);
+	}
+}
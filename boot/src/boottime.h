@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file boottime.h
+ * @brief Boot timing instrumentation for pblboot.
+ *
+ * @see pb/boottime.h for the record handed to the firmware.
+ */
+
+#ifndef BOOT_SRC_BOOTTIME_H_
+#define BOOT_SRC_BOOTTIME_H_
+
+#include <stdint.h>
+
+#include <pb/boottime.h>
+
+#ifdef CONFIG_PB_BOOTTIME
+
+/**
+ * @brief Initialize boot timing instrumentation.
+ *
+ * This takes the @ref PB_BOOTTIME_MARK_MAIN mark.
+ */
+void pb_boottime_init(void);
+
+/**
+ * @brief Get the current boot timing counter value.
+ *
+ * @return Counter value.
+ */
+uint32_t pb_boottime_now(void);
+
+/**
+ * @brief Convert a boot timing counter difference to microseconds.
+ *
+ * @param ticks Counter difference.
+ *
+ * @return Duration in microseconds.
+ */
+uint32_t pb_boottime_to_us(uint32_t ticks);
+
+/**
+ * @brief Take a boot timing mark.
+ *
+ * @param mark Mark.
+ */
+void pb_boottime_mark(enum pb_boottime_mark mark);
+
+/**
+ * @brief Record the duration of an image validation.
+ *
+ * @param validation Validation.
+ * @param start Counter value when validation started.
+ */
+void pb_boottime_validation(enum pb_boottime_validation validation, uint32_t start);
+
+/**
+ * @brief Record the execution of a boot task.
+ *
+ * Tasks are not part of the record handed to the firmware. If
+ * @kconfig{CONFIG_PB_BOOTTIME_LOG} is enabled, the task start and end times
+ * relative to @ref PB_BOOTTIME_MARK_MAIN are logged, so that the critical path
+ * of the boot sequence can be found.
+ *
+ * @param name Task name.
+ * @param start Counter value when the task started.
+ * @param end Counter value when the task ended.
+ */
+void pb_boottime_task(const char *name, uint32_t start, uint32_t end);
+
+/**
+ * @brief Commit the boot timing record to retained memory.
+ *
+ * This must be called right before jumping to the firmware. If
+ * @kconfig{CONFIG_PB_BOOTTIME_LOG} is enabled, the record is also logged.
+ */
+void pb_boottime_commit(void);
+
+#else
+
+static inline void pb_boottime_init(void)
+{
+}
+
+static inline uint32_t pb_boottime_now(void)
+{
+	return 0U;
+}
+
+static inline uint32_t pb_boottime_to_us(uint32_t ticks)
+{
+	return 0U;
+}
+
+static inline void pb_boottime_mark(enum pb_boottime_mark mark)
+{
+}
+
+static inline void pb_boottime_validation(enum pb_boottime_validation validation,
+					  uint32_t start)
+{
+}
+
+static inline void pb_boottime_task(const char *name, uint32_t start, uint32_t end)
+{
+}
+
+static inline void pb_boottime_commit(void)
+{
+}
+
+#endif /* CONFIG_PB_BOOTTIME */
+
+#endif /* BOOT_SRC_BOOTTIME_H_ */
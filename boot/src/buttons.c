@@ -4,6 +4,7 @@
  */
 
 #include "buttons.h"
+#include "watchdog.h"
 
 #include <errno.h>
 
@@ -11,6 +12,7 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
 
 LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
 
@@ -19,10 +21,100 @@ static const struct gpio_dt_spec btn_up = GPIO_DT_SPEC_GET(DT_CHOSEN(pb_btn_up),
 static const struct gpio_dt_spec btn_center = GPIO_DT_SPEC_GET(DT_CHOSEN(pb_btn_center), gpios);
 static const struct gpio_dt_spec btn_down = GPIO_DT_SPEC_GET(DT_CHOSEN(pb_btn_down), gpios);
 
+static const struct gpio_dt_spec *const btns[] = {
+	&btn_back,
+	&btn_up,
+	&btn_center,
+	&btn_down,
+};
+
+#define BTN_BACK   BIT(0)
+#define BTN_UP     BIT(1)
+#define BTN_CENTER BIT(2)
+#define BTN_DOWN   BIT(3)
+
+#define BTN_ALL       (BTN_BACK | BTN_UP | BTN_CENTER | BTN_DOWN)
+#define BTN_PRF_COMBO (BTN_BACK | BTN_UP | BTN_CENTER)
+
+static struct gpio_callback btn_cbs[ARRAY_SIZE(btns)];
+
+/* PRF combo tracking, updated from GPIO interrupts */
+static struct {
+	bool seen;
+	bool held;
+	uint32_t since;
+	uint32_t released;
+} combo;
+
+/* read all buttons, with one port read per group of buttons on the same port */
+static uint32_t buttons_state_get(void)
+{
+	const struct device *port = NULL;
+	gpio_port_value_t value = 0U;
+	uint32_t state = 0U;
+	int ret;
+
+	ARRAY_FOR_EACH(btns, i) {
+		if (btns[i]->port != port) {
+			port = btns[i]->port;
+			ret = gpio_port_get(port, &value);
+			if (ret < 0) {
+				value = 0U;
+			}
+		}
+
+		if ((value & BIT(btns[i]->pin)) != 0U) {
+			state |= BIT(i);
+		}
+	}
+
+	return state;
+}
+
 static inline bool buttons_prf_pressed(void)
 {
-	return (gpio_pin_get_dt(&btn_back) == 1) && (gpio_pin_get_dt(&btn_up) == 1) &&
-	       (gpio_pin_get_dt(&btn_center) == 1) && (gpio_pin_get_dt(&btn_down) == 0);
+	return (buttons_state_get() & BTN_ALL) == BTN_PRF_COMBO;
+}
+
+/* sample buttons on every edge, must be called with interrupts locked */
+static void buttons_combo_update(void)
+{
+	uint32_t now = k_cycle_get_32();
+
+	if (buttons_prf_pressed()) {
+		if (combo.held) {
+			return;
+		}
+
+		/* a press right after a release is contact bounce */
+		if (!combo.seen ||
+		    ((now - combo.released) >= k_ms_to_cyc_ceil32(CONFIG_PB_BUTTON_DEBOUNCE_MS))) {
+			combo.since = now;
+		}
+
+		combo.seen = true;
+		combo.held = true;
+	} else if (combo.held) {
+		combo.held = false;
+		combo.released = now;
+	}
+}
+
+static void buttons_edge(const struct device *port, struct gpio_callback *cb, uint32_t pins)
+{
+	unsigned int key = irq_lock();
+
+	buttons_combo_update();
+
+	irq_unlock(key);
+}
+
+static void buttons_prf_disarm(void)
+{
+	ARRAY_FOR_EACH(btns, i) {
+		(void)gpio_pin_interrupt_configure_dt(btns[i], GPIO_INT_DISABLE);
+		(void)gpio_remove_callback_dt(btns[i], &btn_cbs[i]);
+	}
 }
 
 int pb_buttons_init(void)
@@ -62,28 +154,88 @@ int pb_buttons_init(void)
 	return 0;
 }
 
-bool pb_buttons_prf_requested(void)
+int pb_buttons_prf_arm(void)
 {
-	if (!buttons_prf_pressed()) {
-		return false;
+	int ret;
+
+	ARRAY_FOR_EACH(btns, i) {
+		gpio_init_callback(&btn_cbs[i], buttons_edge, BIT(btns[i]->pin));
+
+		ret = gpio_add_callback_dt(btns[i], &btn_cbs[i]);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = gpio_pin_interrupt_configure_dt(btns[i], GPIO_INT_EDGE_BOTH);
+		if (ret < 0) {
+			return ret;
+		}
 	}
 
-	LOG_INF("PRF button combo detected, waiting %d ms to confirm",
-		CONFIG_PB_PRF_BUTTON_COMBO_TIME_MS);
+	/* the combo is usually held before reset, so no edge will be seen */
+	buttons_edge(NULL, NULL, 0U);
+
+	return 0;
+}
 
-	for (unsigned int i = 0U; i < CONFIG_PB_PRF_BUTTON_COMBO_TIME_MS; i++) {
-		k_msleep(1);
-		if (!buttons_prf_pressed()) {
+bool pb_buttons_prf_requested(void)
+{
+	bool logged = false;
+	bool confirmed;
+
+	/* boot is on hold until the combo is confirmed or released */
+	while (true) {
+		unsigned int key;
+		uint32_t held_for;
+		uint32_t released_for;
+		bool seen;
+		bool held;
+
+		key = irq_lock();
+		buttons_combo_update();
+		seen = combo.seen;
+		held = combo.held;
+		held_for = k_cycle_get_32() - combo.since;
+		released_for = k_cycle_get_32() - combo.released;
+		irq_unlock(key);
+
+		confirmed = held &&
+			    (held_for >= k_ms_to_cyc_ceil32(CONFIG_PB_PRF_BUTTON_COMBO_TIME_MS));
+		if (confirmed || !seen) {
+			break;
+		}
+
+		if (!held && (released_for >= k_ms_to_cyc_ceil32(CONFIG_PB_BUTTON_DEBOUNCE_MS))) {
 			LOG_INF("Button combo released");
-			return false;
+			break;
+		}
+
+		if (!logged) {
+			LOG_INF("PRF button combo detected, waiting to confirm");
+			logged = true;
+		}
+
+		(void)pb_watchdog_feed();
+
+		/* edges are timestamped by interrupts, let other threads run meanwhile */
+		if (IS_ENABLED(CONFIG_MULTITHREADING)) {
+			k_msleep(1);
+		} else {
+			k_busy_wait(USEC_PER_MSEC);
 		}
 	}
 
-	return true;
+	buttons_prf_disarm();
+
+	return confirmed;
+}
+
+void pb_buttons_prf_cancel(void)
+{
+	buttons_prf_disarm();
 }
 
 bool pb_buttons_any_pressed(void)
 {
-	return (gpio_pin_get_dt(&btn_back) == 1) || (gpio_pin_get_dt(&btn_up) == 1) ||
-	       (gpio_pin_get_dt(&btn_center) == 1) || (gpio_pin_get_dt(&btn_down) == 1);
+	return buttons_state_get() != 0U;
 }
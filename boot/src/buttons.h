@@ -25,14 +25,35 @@
  */
 int pb_buttons_init(void);
 
+/**
+ * @brief Start tracking the PRF button combo
+ *
+ * Button edges are tracked with interrupts, so that the combo hold time runs
+ * while the bootloader does other work (e.g. validating firmware). A combo
+ * already held when arming is also tracked.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int pb_buttons_prf_arm(void);
+
 /**
  * @brief Check if PRF  was requested
  *
+ * If the combo is being held, this function busy waits until it has been held
+ * for @kconfig{CONFIG_PB_PRF_BUTTON_COMBO_TIME_MS} (counted from the first
+ * press seen since arming) or released. Combo tracking is stopped afterwards.
+ *
  * @retval true if PRF mode was requested
  * @retval false if PRF mode was not requested
  */
 bool pb_buttons_prf_requested(void);
 
+/**
+ * @brief Stop tracking the PRF button combo
+ */
+void pb_buttons_prf_cancel(void);
+
 /**
  * @brief Check if any button is currently pressed
  *
@@ -4,6 +4,7 @@
  */
 
 #include "charger.h"
+#include "handoff.h"
 
 #include <inttypes.h>
 #include <errno.h>
@@ -48,6 +49,8 @@ bool pb_charger_allow_boot(void)
 	}
 
 	int32_t vbat_mv = val.val1 * 1000 + val.val2 / 1000;
+	pb_handoff_vbat(vbat_mv);
+
 	if (vbat_mv >= CONFIG_PB_VBAT_MIN_BOOT_MV) {
 		return true;
 	} else {
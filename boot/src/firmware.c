@@ -3,95 +3,435 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "bootlog.h"
+#include "bootstate.h"
+#include "boottime.h"
 #include "firmware.h"
+#include "handoff.h"
+#include "image.h"
+#include "valcache.h"
 
 #include <errno.h>
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
-#include <zephyr/device.h>
 #include <zephyr/devicetree.h>
-#include <zephyr/drivers/flash.h>
 #include <zephyr/logging/log.h>
-#include <zephyr/sys/crc.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
 
 #include <pb/bootbit.h>
+#include <pb/crc.h>
+#include <pb/drivers/console/pulse_uart_console.h>
 #include <pb/fwjump.h>
+#include <pb/sha256.h>
 
 LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
 
 #define SLOT0_ADDR DT_REG_ADDR(DT_CHOSEN(pb_slot0))
+#define SLOT0_SIZE DT_REG_SIZE(DT_CHOSEN(pb_slot0))
 #define SLOT1_ADDR DT_REG_ADDR(DT_CHOSEN(pb_slot1))
+#define SLOT1_SIZE DT_REG_SIZE(DT_CHOSEN(pb_slot1))
 #define PRF_ADDR   DT_REG_ADDR(DT_CHOSEN(pb_prf))
+#define PRF_SIZE   DT_REG_SIZE(DT_CHOSEN(pb_prf))
 
-#define PBLBOOT_MAGIC 0x96f3b83dUL
+/* image trailer, if any */
+#define TRAILER_LENGTH (IS_ENABLED(CONFIG_PB_IMAGE_SHA256) ? sizeof(struct firmware_sha256) : 0U)
 
-struct firmware_header {
-	uint32_t magic;
-	uint32_t header_length;
-	uint64_t timestamp;
-	uint32_t start_offset;
-	uint32_t length;
+/* number of block digests read at once */
+#define DIGESTS_CHUNK 16U
+
+/* digests computed in a single pass over the image */
+struct firmware_digest {
 	uint32_t crc;
-} __packed;
+	/* whole image CRC, combined from block CRCs (v2) */
+	uint32_t image_crc;
+#ifdef CONFIG_PB_IMAGE_SHA256
+	struct pb_sha256 sha256;
+	bool sha256_enabled;
+#endif
+};
 
-static uint8_t buf[CONFIG_PB_FLASH_READ_BUF_SIZE];
-static const struct device *flash = DEVICE_DT_GET(DT_CHOSEN(zephyr_flash_controller));
+static inline uint32_t firmware_block_count(const struct firmware_header *hdr)
+{
+	return DIV_ROUND_UP(hdr->length, hdr->block_size);
+}
 
-static int firmware_header_get(uint32_t address, struct firmware_header *hdr)
+int pb_firmware_header_check(struct firmware_header *hdr, uint32_t size)
+{
+	if (hdr->magic != PBLBOOT_MAGIC) {
+		return -EINVAL;
+	}
+
+	/* binary (and trailer) must follow the header, within the slot */
+	if ((hdr->start_offset < hdr->header_length) ||
+	    (((uint64_t)hdr->start_offset + hdr->length + TRAILER_LENGTH) > size)) {
+		return -EINVAL;
+	}
+
+	if (hdr->header_length == PBLBOOT_HEADER_V1_LENGTH) {
+		hdr->block_size = 0U;
+		hdr->table_offset = 0U;
+		hdr->table_crc = 0U;
+		return 0;
+	}
+
+	/* digest table lies between the header and the binary */
+	if ((hdr->header_length != PBLBOOT_HEADER_V2_LENGTH) || (hdr->block_size == 0U) ||
+	    (hdr->table_offset < hdr->header_length) ||
+	    ((hdr->table_offset + ((uint64_t)firmware_block_count(hdr) * sizeof(uint32_t))) >
+	     hdr->start_offset)) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int pb_firmware_header_get(uint32_t address, uint32_t size, struct firmware_header *hdr)
 {
 	int ret;
 
-	ret = flash_read(flash, address, hdr, sizeof(*hdr));
+	ret = pb_image_read(address, hdr, sizeof(*hdr));
 	if (ret < 0) {
-		LOG_ERR("Failed to read from flash (err %d)", ret);
 		return ret;
 	}
 
-	if ((hdr->magic != PBLBOOT_MAGIC) || (hdr->header_length != sizeof(*hdr))) {
-		return -EINVAL;
+	return pb_firmware_header_check(hdr, size);
+}
+
+static int firmware_crc_update(const uint8_t *data, size_t len, void *user_data)
+{
+	uint32_t *crc = user_data;
+
+	*crc = pb_crc32_ieee_update(*crc, data, len);
+
+	return 0;
+}
+
+static int firmware_digest_update(const uint8_t *data, size_t len, void *user_data)
+{
+	struct firmware_digest *digest = user_data;
+
+	digest->crc = pb_crc32_ieee_update(digest->crc, data, len);
+
+#ifdef CONFIG_PB_IMAGE_SHA256
+	if (digest->sha256_enabled) {
+		return pb_sha256_update(&digest->sha256, data, len);
 	}
+#endif
 
 	return 0;
 }
 
-static int firmware_validate(uint32_t address, const struct firmware_header *hdr)
+#ifdef CONFIG_PB_IMAGE_SHA256
+static int firmware_sha256_check(uint32_t address, const struct firmware_header *hdr,
+				 struct firmware_digest *digest)
+{
+	uint8_t computed[PB_SHA256_SIZE];
+	struct firmware_sha256 trailer;
+	int ret;
+
+	ret = pb_sha256_final(&digest->sha256, computed);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = pb_image_read(address + hdr->start_offset + hdr->length, &trailer, sizeof(trailer));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if ((trailer.magic != PBLBOOT_SHA256_MAGIC) ||
+	    (memcmp(trailer.digest, computed, sizeof(computed)) != 0)) {
+		LOG_ERR("Image SHA-256 mismatch");
+		return -EIO;
+	}
+
+	return 0;
+}
+#else
+static inline int firmware_sha256_check(uint32_t address, const struct firmware_header *hdr,
+					struct firmware_digest *digest)
+{
+	return 0;
+}
+#endif /* CONFIG_PB_IMAGE_SHA256 */
+
+static int firmware_table_validate(uint32_t address, const struct firmware_header *hdr)
 {
 	int ret;
-	uint32_t pending;
-	uint32_t addr;
 	uint32_t crc;
 
-	crc = crc32_ieee(NULL, 0U);
-	pending = hdr->length;
-	addr = address + hdr->start_offset;
-	while (pending > 0U) {
-		size_t len = MIN(sizeof(buf), pending);
-		ret = flash_read(flash, addr, buf, len);
+	crc = pb_crc32_ieee(NULL, 0U);
+
+	ret = pb_image_stream(address + hdr->table_offset,
+			      firmware_block_count(hdr) * sizeof(uint32_t), firmware_crc_update,
+			      &crc);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (crc != hdr->table_crc) {
+		LOG_ERR("Image digest table corrupted");
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int firmware_blocks_validate(uint32_t address, const struct firmware_header *hdr,
+				    uint32_t first, uint32_t count, struct firmware_digest *digest)
+{
+	uint32_t digests[DIGESTS_CHUNK];
+	uint32_t table;
+	uint32_t block;
+	uint32_t off;
+	uint32_t len;
+	uint32_t op;
+	int ret;
+
+	table = address + hdr->table_offset;
+	op = pb_crc32_ieee_combine_gen(hdr->block_size);
+
+	for (uint32_t i = 0U; i < count; i++) {
+		block = first + i;
+
+		if ((i % DIGESTS_CHUNK) == 0U) {
+			ret = pb_image_read(table + (block * sizeof(uint32_t)), digests,
+					    MIN(DIGESTS_CHUNK, count - i) * sizeof(uint32_t));
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		/* other digests (if any) span all blocks */
+		off = block * hdr->block_size;
+		len = MIN(hdr->block_size, hdr->length - off);
+		digest->crc = pb_crc32_ieee(NULL, 0U);
+
+		ret = pb_image_stream(address + hdr->start_offset + off, len,
+				      firmware_digest_update, digest);
 		if (ret < 0) {
-			LOG_ERR("Failed to read from flash (err %d)", ret);
 			return ret;
 		}
 
-		crc = crc32_ieee_update(crc, buf, len);
+		/* no need to read any further */
+		if (digest->crc != digests[i % DIGESTS_CHUNK]) {
+			LOG_ERR("Image block %" PRIu32 " corrupted", block);
+			return -EIO;
+		}
+
+		/* only the last block may be shorter */
+		if (len != hdr->block_size) {
+			op = pb_crc32_ieee_combine_gen(len);
+		}
 
-		pending -= len;
-		addr += len;
+		digest->image_crc = pb_crc32_ieee_combine_op(digest->image_crc, digest->crc, op);
 	}
 
-	if (crc != hdr->crc) {
-		return -EIO;
+	return 0;
+}
+
+int pb_firmware_validate_range(uint32_t address, const struct firmware_header *hdr,
+			       uint32_t offset, uint32_t len)
+{
+	struct firmware_digest digest = {0};
+	uint32_t first;
+	uint32_t end;
+	int ret;
+
+	if (hdr->block_size == 0U) {
+		return pb_firmware_validate(address, hdr);
+	}
+
+	ret = firmware_table_validate(address, hdr);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if ((len == 0U) || (offset >= hdr->length)) {
+		return 0;
+	}
+
+	first = offset / hdr->block_size;
+	end = DIV_ROUND_UP(MIN((uint64_t)offset + len, hdr->length), hdr->block_size);
+
+	return firmware_blocks_validate(address, hdr, first, end - first, &digest);
+}
+
+int pb_firmware_validate(uint32_t address, const struct firmware_header *hdr)
+{
+	struct firmware_digest digest = {0};
+	int ret;
+	int err;
+
+#ifdef CONFIG_PB_IMAGE_SHA256
+	ret = pb_sha256_init(&digest.sha256);
+	if (ret < 0) {
+		return ret;
+	}
+
+	digest.sha256_enabled = true;
+#endif
+
+	/*
+	 * all digests are computed in a single pass over the image, the whole
+	 * image CRC is checked for both header versions
+	 */
+	if (hdr->block_size != 0U) {
+		ret = firmware_table_validate(address, hdr);
+		if (ret == 0) {
+			ret = firmware_blocks_validate(address, hdr, 0U, firmware_block_count(hdr),
+						       &digest);
+		}
+
+		if ((ret == 0) && (digest.image_crc != hdr->crc)) {
+			LOG_ERR("Image CRC mismatch");
+			ret = -EIO;
+		}
+	} else {
+		digest.crc = pb_crc32_ieee(NULL, 0U);
+
+		ret = pb_image_stream(address + hdr->start_offset, hdr->length,
+				      firmware_digest_update, &digest);
+		if ((ret == 0) && (digest.crc != hdr->crc)) {
+			ret = -EIO;
+		}
+	}
+
+	/* hash computations must always be completed */
+	err = firmware_sha256_check(address, hdr, &digest);
+
+	return (ret < 0) ? ret : err;
+}
+
+static int firmware_header_crc_get(uint32_t address, const struct firmware_header *hdr,
+				   uint32_t *crc)
+{
+	/* whole header area, including the block digest table of v2 images */
+	*crc = pb_crc32_ieee(NULL, 0U);
+
+	return pb_image_stream(address, hdr->start_offset, firmware_crc_update, crc);
+}
+
+/* firmware slot chosen by pb_firmware_select() */
+static struct {
+	bool valid;
+	uint8_t slot;
+	bool cached;
+	enum pb_handoff_backup backup;
+	uint32_t load_address;
+	struct firmware_header hdr;
+} selected;
+
+static void FUNC_NORETURN firmware_jump(uint32_t load_address)
+{
+	pb_bootbit_commit();
+	pb_bootstate_commit();
+	pb_handoff_commit();
+	pb_boottime_commit();
+	pb_bootlog_commit();
+
+	/* interrupts are disabled on jump, make sure all logs are out */
+	pulse_uart_console_flush();
+
+	pb_fwjump(load_address);
+}
+
+static int firmware_spot_check(uint8_t slot, uint32_t address, const struct firmware_header *hdr)
+{
+	uint32_t count;
+	uint32_t first;
+	uint32_t n;
+
+	/* successive warm resets check the following blocks */
+	count = firmware_block_count(hdr);
+	n = MIN(CONFIG_PB_VALIDATION_SPOT_CHECK_BLOCKS, count);
+	first = pb_valcache_spot_next(slot, n, count);
+
+	return pb_firmware_validate_range(address, hdr, first * hdr->block_size,
+					  n * hdr->block_size);
+}
+
+static int firmware_slot_check(uint8_t slot, uint32_t address, const struct firmware_header *hdr,
+			       bool *cached)
+{
+	uint32_t hdr_crc = 0U;
+	int ret;
+
+	*cached = false;
+
+	if (IS_ENABLED(CONFIG_PB_VALIDATION_CACHE)) {
+		ret = firmware_header_crc_get(address, hdr, &hdr_crc);
+		if (ret < 0) {
+			return ret;
+		}
+
+		*cached = pb_valcache_lookup(slot, hdr, hdr_crc);
+	}
+
+	if (*cached && (hdr->block_size != 0U) && (CONFIG_PB_VALIDATION_SPOT_CHECK_BLOCKS > 0)) {
+		ret = firmware_spot_check(slot, address, hdr);
+		if (ret < 0) {
+			LOG_WRN("slot%" PRIu8 " spot check failed (err %d)", slot, ret);
+			*cached = false;
+		}
+	}
+
+	if (!*cached) {
+		ret = pb_firmware_validate(address, hdr);
+		if (ret < 0) {
+			pb_valcache_invalidate(slot);
+			return ret;
+		}
+
+		pb_valcache_store(slot, hdr, hdr_crc);
 	}
 
 	return 0;
 }
 
+static int firmware_slot_validate(uint8_t slot, uint32_t address,
+				  const struct firmware_header *hdr, bool *cached)
+{
+	uint32_t start;
+	int ret;
+
+	start = pb_boottime_now();
+	ret = firmware_slot_check(slot, address, hdr, cached);
+
+	/* failed validations are timed too, they delay the boot as much */
+	pb_boottime_validation(slot == 0U ? PB_BOOTTIME_VALIDATION_SLOT0
+					  : PB_BOOTTIME_VALIDATION_SLOT1,
+			       start);
+	pb_bootstate_validation(start);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	LOG_INF("slot%" PRIu8 " firmware valid (%s validation)", slot,
+		*cached ? "cached" : "full");
+
+	return 0;
+}
+
 int pb_firmware_init(void)
 {
-	if (!device_is_ready(flash)) {
-		LOG_ERR("Flash device not ready");
-		return -ENODEV;
+	int ret;
+
+	ret = pb_image_init();
+	if (ret < 0) {
+		LOG_ERR("Failed to initialize image access (err %d)", ret);
+		return ret;
+	}
+
+	ret = pb_valcache_init();
+	if (ret < 0) {
+		LOG_ERR("Failed to initialize validation cache (err %d)", ret);
+		return ret;
 	}
 
 	return 0;
@@ -100,84 +440,123 @@ int pb_firmware_init(void)
 int pb_firmware_load_prf(void)
 {
 	uint32_t prf_load_address;
+	uint32_t start;
 	struct firmware_header hdr;
 	int ret;
 
-	ret = firmware_header_get(PRF_ADDR, &hdr);
+	ret = pb_firmware_header_get(PRF_ADDR, PRF_SIZE, &hdr);
 	if (ret < 0) {
 		LOG_ERR("PRF not found or invalid (err %d)", ret);
 		return ret;
 	}
 
-	ret = firmware_validate(PRF_ADDR, &hdr);
+	start = pb_boottime_now();
+	ret = pb_firmware_validate(PRF_ADDR, &hdr);
+	pb_boottime_validation(PB_BOOTTIME_VALIDATION_PRF, start);
+	pb_bootstate_validation(start);
 	if (ret < 0) {
 		LOG_ERR("PRF image is corrupted");
 		return ret;
 	}
 
 	pb_bootbit_prf_starting_set();
+	pb_bootstate_slot(PB_BOOTSTATE_SLOT_PRF);
 
 	prf_load_address = CONFIG_FLASH_BASE_ADDRESS + PRF_ADDR + hdr.start_offset;
+	pb_handoff_image(PB_HANDOFF_SLOT_PRF, prf_load_address, &hdr, false);
 	LOG_INF("Loading PRF at address 0x%" PRIx32, prf_load_address);
-	pb_fwjump(prf_load_address);
+	firmware_jump(prf_load_address);
 
 	return 0;
 }
 
-int pb_firmware_load(void)
+int pb_firmware_select(void)
 {
-	struct firmware_header slot0_hdr;
-	struct firmware_header slot1_hdr;
-	uint32_t slot0_load_address = 0U;
-	uint32_t slot1_load_address = 0U;
-	bool slot0_valid;
-	bool slot1_valid;
+	static const uint32_t slot_addrs[] = {SLOT0_ADDR, SLOT1_ADDR};
+	static const uint32_t slot_sizes[] = {SLOT0_SIZE, SLOT1_SIZE};
+	struct firmware_header hdrs[ARRAY_SIZE(slot_addrs)];
+	bool hdrs_valid[ARRAY_SIZE(slot_addrs)];
+	enum pb_handoff_backup backups[ARRAY_SIZE(slot_addrs)];
+	uint8_t order[ARRAY_SIZE(slot_addrs)];
 	int ret;
 
-	slot0_valid = false;
-	ret = firmware_header_get(SLOT0_ADDR, &slot0_hdr);
-	if (ret == 0) {
-		ret = firmware_validate(SLOT0_ADDR, &slot0_hdr);
-		if (ret == 0) {
-			slot0_valid = true;
-			slot0_load_address =
-				CONFIG_FLASH_BASE_ADDRESS + SLOT0_ADDR + slot0_hdr.start_offset;
-			LOG_INF("slot0 firmware valid (0x%" PRIx32 ", %" PRIu64 ")",
-				slot0_load_address, slot0_hdr.timestamp);
+	selected.valid = false;
+
+	/* headers are cheap to read, use them to sort candidates */
+	for (uint8_t i = 0U; i < ARRAY_SIZE(slot_addrs); i++) {
+		hdrs_valid[i] = pb_firmware_header_get(slot_addrs[i], slot_sizes[i], &hdrs[i]) == 0;
+		if (!hdrs_valid[i]) {
+			LOG_INF("slot%" PRIu8 " has no valid header", i);
 		}
+
+		backups[i] = hdrs_valid[i] ? PB_HANDOFF_BACKUP_UNCHECKED : PB_HANDOFF_BACKUP_EMPTY;
 	}
 
-	slot1_valid = false;
-	ret = firmware_header_get(SLOT1_ADDR, &slot1_hdr);
-	if (ret == 0) {
-		ret = firmware_validate(SLOT1_ADDR, &slot1_hdr);
-		if (ret == 0) {
-			slot1_valid = true;
-			slot1_load_address =
-				CONFIG_FLASH_BASE_ADDRESS + SLOT1_ADDR + slot1_hdr.start_offset;
-			LOG_INF("slot1 firmware valid (0x%" PRIx32 ", %" PRIu64 ")",
-				slot1_load_address, slot1_hdr.timestamp);
-		}
+	/* newest first, slot0 preferred if equal */
+	if (hdrs_valid[1] && (!hdrs_valid[0] || (hdrs[1].timestamp > hdrs[0].timestamp))) {
+		order[0] = 1U;
+		order[1] = 0U;
+	} else {
+		order[0] = 0U;
+		order[1] = 1U;
 	}
 
-	if (slot0_valid) {
-		if (slot1_valid && (slot1_hdr.timestamp > slot0_hdr.timestamp)) {
-			LOG_INF("Loading slot1 firmware @ 0x%" PRIx32, slot1_load_address);
-			pb_fwjump(slot1_load_address);
-		} else {
-			LOG_INF("Loading slot0 firmware @ 0x%" PRIx32, slot0_load_address);
-			pb_fwjump(slot0_load_address);
+	/* only validate the first candidate that passes */
+	for (uint8_t i = 0U; i < ARRAY_SIZE(order); i++) {
+		uint8_t slot = order[i];
+		bool cached;
+
+		if (!hdrs_valid[slot]) {
+			continue;
 		}
-	} else if (slot1_valid) {
-		if (slot0_valid && (slot0_hdr.timestamp > slot1_hdr.timestamp)) {
-			LOG_INF("Loading slot0 firmware @ 0x%" PRIx32, slot0_load_address);
-			pb_fwjump(slot0_load_address);
-		} else {
-			LOG_INF("Loading slot1 firmware @ 0x%" PRIx32, slot1_load_address);
-			pb_fwjump(slot1_load_address);
+
+		ret = firmware_slot_validate(slot, slot_addrs[slot], &hdrs[slot], &cached);
+		if (ret < 0) {
+			LOG_ERR("slot%" PRIu8 " firmware corrupted (err %d)", slot, ret);
+			backups[slot] = PB_HANDOFF_BACKUP_INVALID;
+			continue;
 		}
-	} else {
+
+		selected.valid = true;
+		selected.slot = slot;
+		selected.cached = cached;
+		selected.backup = backups[1U - slot];
+		selected.hdr = hdrs[slot];
+		selected.load_address =
+			CONFIG_FLASH_BASE_ADDRESS + slot_addrs[slot] + hdrs[slot].start_offset;
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+int pb_firmware_selected_slot(uint8_t *slot)
+{
+	if (!selected.valid) {
+		return -ENOENT;
+	}
+
+	*slot = selected.slot;
+
+	return 0;
+}
+
+int pb_firmware_load(void)
+{
+	if (!selected.valid) {
 		LOG_ERR("No valid firmware image");
+		pb_bootstate_reason(PB_BOOTSTATE_REASON_NO_FW);
 		return pb_firmware_load_prf();
 	}
+
+	LOG_INF("Loading slot%" PRIu8 " firmware @ 0x%" PRIx32 " (%" PRIu64 ")", selected.slot,
+		selected.load_address, selected.hdr.timestamp);
+	pb_bootstate_slot((enum pb_bootstate_slot)selected.slot);
+	pb_handoff_image((enum pb_handoff_slot)selected.slot, selected.load_address, &selected.hdr,
+			 selected.cached);
+	pb_handoff_backup(selected.backup);
+	firmware_jump(selected.load_address);
+
+	return 0;
 }
@@ -6,6 +6,140 @@
 #ifndef BOOT_SRC_FIRMWARE_H_
 #define BOOT_SRC_FIRMWARE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#include <pb/sha256.h>
+
+/** Firmware image magic number */
+#define PBLBOOT_MAGIC 0x96f3b83dUL
+
+/** Firmware image SHA-256 trailer magic number ("PBSH") */
+#define PBLBOOT_SHA256_MAGIC 0x48534250UL
+
+/** Length of a version 1 image header (no block digest table) */
+#define PBLBOOT_HEADER_V1_LENGTH offsetof(struct firmware_header, block_size)
+
+/** Length of a version 2 image header (block digest table) */
+#define PBLBOOT_HEADER_V2_LENGTH sizeof(struct firmware_header)
+
+/**
+ * @brief Firmware image header
+ *
+ * The header version is given by its length. Version 2 headers point to a table
+ * of CRC32-IEEE digests placed between the header and the firmware binary, one
+ * for each @c block_size bytes of the binary, which allows corruption to be
+ * detected on the first bad block, and subsets of the image to be verified.
+ *
+ * The whole image @c crc is authoritative for both versions: a full validation
+ * only succeeds if it matches (for version 2 headers, it is combined from the
+ * block CRCs, so the image is still read once). Block digests are only relied
+ * upon alone when validating part of an image (see
+ * pb_firmware_validate_range()), and are themselves protected by
+ * @c table_crc.
+ *
+ * Version 2 fields are zeroed when a version 1 header is read.
+ */
+struct firmware_header {
+	/** Magic number (@ref PBLBOOT_MAGIC) */
+	uint32_t magic;
+	/** Size of the header structure */
+	uint32_t header_length;
+	/** Build timestamp, used for version comparison */
+	uint64_t timestamp;
+	/** Offset to the firmware code */
+	uint32_t start_offset;
+	/** Firmware binary size */
+	uint32_t length;
+	/** CRC32-IEEE checksum of the firmware binary */
+	uint32_t crc;
+	/** Block size of the digest table (v2) */
+	uint32_t block_size;
+	/** Offset to the digest table (v2) */
+	uint32_t table_offset;
+	/** CRC32-IEEE checksum of the digest table (v2) */
+	uint32_t table_crc;
+} __packed;
+
+/**
+ * @brief Firmware image SHA-256 trailer
+ *
+ * Placed right after the firmware binary, and required when
+ * @kconfig{CONFIG_PB_IMAGE_SHA256} is enabled.
+ */
+struct firmware_sha256 {
+	/** Magic number (@ref PBLBOOT_SHA256_MAGIC) */
+	uint32_t magic;
+	/** SHA-256 digest of the firmware binary */
+	uint8_t digest[PB_SHA256_SIZE];
+} __packed;
+
+/**
+ * @brief Check a firmware image header.
+ *
+ * Both header versions are accepted. Version 2 fields of a version 1 header
+ * are zeroed. The firmware binary, and its SHA-256 trailer if
+ * @kconfig{CONFIG_PB_IMAGE_SHA256} is enabled, must fit in @p size.
+ *
+ * @param[in,out] hdr Image header, as read from flash.
+ * @param size Size of the slot holding the image.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the header is not valid
+ */
+int pb_firmware_header_check(struct firmware_header *hdr, uint32_t size);
+
+/**
+ * @brief Read and check a firmware image header.
+ *
+ * @param address Image flash offset.
+ * @param size Size of the slot holding the image.
+ * @param[out] hdr Image header.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the header is not valid
+ * @retval -errno other negative error code on failure
+ */
+int pb_firmware_header_get(uint32_t address, uint32_t size, struct firmware_header *hdr);
+
+/**
+ * @brief Validate a firmware image against its header.
+ *
+ * Images with a version 2 header are validated block by block, stopping at the
+ * first corrupted block, then against the whole image CRC. All enabled digests
+ * (CRC32-IEEE, and SHA-256 if @kconfig{CONFIG_PB_IMAGE_SHA256} is enabled) are
+ * computed in a single pass over the image.
+ *
+ * @param address Image flash offset.
+ * @param hdr Image header.
+ *
+ * @retval 0 on success
+ * @retval -EIO if a block CRC, the image CRC or SHA-256 does not match
+ * @retval -errno other negative error code on failure
+ */
+int pb_firmware_validate(uint32_t address, const struct firmware_header *hdr);
+
+/**
+ * @brief Validate part of a firmware image against its header.
+ *
+ * Only the blocks overlapping the given range of the firmware binary are
+ * validated, after the digest table itself has been checked. Images with a
+ * version 1 header can only be validated as a whole, so the range is ignored.
+ *
+ * @param address Image flash offset.
+ * @param hdr Image header.
+ * @param offset Range offset, relative to the firmware binary start.
+ * @param len Range length.
+ *
+ * @retval 0 on success
+ * @retval -EIO if a block CRC does not match
+ * @retval -errno other negative error code on failure
+ */
+int pb_firmware_validate_range(uint32_t address, const struct firmware_header *hdr,
+			       uint32_t offset, uint32_t len);
+
 /**
  * @brief Initialize the firmware module
  *
@@ -22,12 +156,34 @@ int pb_firmware_init(void);
  */
 int pb_firmware_load_prf(void);
 
+/**
+ * @brief Select the normal firmware
+ *
+ * This function will validate the most recent valid firmware from either
+ * slot0 or slot1, falling back to the other slot if it is corrupted. The
+ * selected slot is booted by pb_firmware_load(), so that other boot decisions
+ * (e.g. PRF button combo) can be taken while validation runs.
+ *
+ * @retval 0 on success
+ * @retval -ENOENT if neither slot contains a valid firmware image
+ */
+int pb_firmware_select(void);
+
+/**
+ * @brief Get the firmware slot chosen by pb_firmware_select()
+ *
+ * @param[out] slot Selected slot (0 or 1).
+ *
+ * @retval 0 on success
+ * @retval -ENOENT if no valid firmware image was selected
+ */
+int pb_firmware_selected_slot(uint8_t *slot);
+
 /**
  * @brief Load the normal firmware
  *
- * This function will load the most recent valid firmware from either slot0
- * or slot1. If neither slot contains a valid firmware image, the PRF will be
- * loaded instead.
+ * This function will load the firmware selected by pb_firmware_select(). If
+ * no valid firmware image was selected, the PRF will be loaded instead.
  *
  * @retval 0 on success
  * @retval -errno negative error code on failure
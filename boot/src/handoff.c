@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "handoff.h"
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/hwinfo.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/retention/retention.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
+
+static const struct device *retention = DEVICE_DT_GET(DT_CHOSEN(pb_handoff));
+static struct pb_handoff handoff = {
+	.version = PB_HANDOFF_VERSION,
+};
+
+void pb_handoff_image(enum pb_handoff_slot slot, uint32_t load_address,
+		      const struct firmware_header *hdr, bool cached)
+{
+	handoff.slot = (uint8_t)slot;
+	handoff.load_address = load_address;
+	handoff.timestamp = hdr->timestamp;
+	handoff.image_size = hdr->length;
+	handoff.image_crc = hdr->crc;
+
+	/* a cached image body was not checked on this boot */
+	handoff.flags &= ~(PB_HANDOFF_FLAG_VERIFIED | PB_HANDOFF_FLAG_CACHED);
+	if (cached) {
+		handoff.flags |= PB_HANDOFF_FLAG_CACHED;
+	} else {
+		handoff.flags |= PB_HANDOFF_FLAG_VERIFIED;
+	}
+}
+
+void pb_handoff_backup(enum pb_handoff_backup backup)
+{
+	handoff.backup = (uint8_t)backup;
+}
+
+void pb_handoff_vbat(int32_t vbat_mv)
+{
+	handoff.vbat_mv = (uint16_t)CLAMP(vbat_mv, 0, UINT16_MAX);
+	handoff.flags |= PB_HANDOFF_FLAG_VBAT_VALID;
+}
+
+void pb_handoff_commit(void)
+{
+	int ret;
+
+#ifdef CONFIG_HWINFO
+	if (hwinfo_get_reset_cause(&handoff.reset_cause) == 0) {
+		handoff.flags |= PB_HANDOFF_FLAG_RESET_CAUSE_VALID;
+	}
+#endif
+
+	if (!device_is_ready(retention)) {
+		return;
+	}
+
+	ret = retention_write(retention, 0U, (const uint8_t *)&handoff, sizeof(handoff));
+	if (ret < 0) {
+		LOG_ERR("Failed to write handoff record (err %d)", ret);
+	}
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file handoff.h
+ * @brief Bootloader to firmware handoff for pblboot.
+ *
+ * @see pb/handoff.h for the record handed to the firmware.
+ */
+
+#ifndef BOOT_SRC_HANDOFF_H_
+#define BOOT_SRC_HANDOFF_H_
+
+#include "firmware.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <pb/handoff.h>
+
+#ifdef CONFIG_PB_HANDOFF
+
+/**
+ * @brief Record the image about to be booted.
+ *
+ * @param slot Image slot.
+ * @param load_address Image load address.
+ * @param hdr Image header.
+ * @param cached Whether verification was skipped thanks to the validation
+ * cache, in which case the image is not flagged as verified.
+ */
+void pb_handoff_image(enum pb_handoff_slot slot, uint32_t load_address,
+		      const struct firmware_header *hdr, bool cached);
+
+/**
+ * @brief Record the state of the firmware slot not booted.
+ *
+ * @param backup Backup slot state.
+ */
+void pb_handoff_backup(enum pb_handoff_backup backup);
+
+/**
+ * @brief Record the battery voltage.
+ *
+ * @param vbat_mv Battery voltage (mV).
+ */
+void pb_handoff_vbat(int32_t vbat_mv);
+
+/**
+ * @brief Commit the handoff record to retained memory.
+ *
+ * This must be called right before jumping to the image.
+ */
+void pb_handoff_commit(void);
+
+#else
+
+static inline void pb_handoff_image(enum pb_handoff_slot slot, uint32_t load_address,
+				    const struct firmware_header *hdr, bool cached)
+{
+}
+
+static inline void pb_handoff_backup(enum pb_handoff_backup backup)
+{
+}
+
+static inline void pb_handoff_vbat(int32_t vbat_mv)
+{
+}
+
+static inline void pb_handoff_commit(void)
+{
+}
+
+#endif /* CONFIG_PB_HANDOFF */
+
+#endif /* BOOT_SRC_HANDOFF_H_ */
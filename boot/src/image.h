@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file image.h
+ * @brief Firmware image access for pblboot.
+ *
+ * Provides random reads (e.g. headers) and sequential streaming of image
+ * contents stored in flash. Streaming is the hot path of image validation, so
+ * it may overlap flash reads with processing of previously read data.
+ *
+ * Two implementations are available: one going through the flash API (see
+ * @kconfig{CONFIG_PB_IMAGE_ACCESS_FLASH}), usable with any storage, and a
+ * zero-copy one reading the memory mapped flash window directly (see
+ * @kconfig{CONFIG_PB_IMAGE_ACCESS_MMAP}).
+ */
+
+#ifndef BOOT_SRC_IMAGE_H_
+#define BOOT_SRC_IMAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Image stream callback.
+ *
+ * @param data Chunk of image data.
+ * @param len Length of the chunk.
+ * @param user_data User data.
+ *
+ * @retval 0 to continue streaming
+ * @retval -errno negative error code to abort streaming
+ */
+typedef int (*pb_image_stream_cb_t)(const uint8_t *data, size_t len, void *user_data);
+
+/**
+ * @brief Initialize the image access module
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int pb_image_init(void);
+
+/**
+ * @brief Read image data.
+ *
+ * @param offset Flash offset.
+ * @param[out] dst Destination buffer.
+ * @param len Number of bytes to read.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int pb_image_read(uint32_t offset, void *dst, size_t len);
+
+/**
+ * @brief Stream image data.
+ *
+ * Data is provided in chunks of at most @kconfig{CONFIG_PB_FLASH_READ_BUF_SIZE}
+ * bytes, in order. Chunks may point directly to the memory mapped flash, so
+ * they must be treated as read-only.
+ *
+ * @param offset Flash offset.
+ * @param len Number of bytes to stream.
+ * @param cb Callback invoked for each chunk.
+ * @param user_data User data passed to @p cb.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure, or the error returned by @p cb
+ */
+int pb_image_stream(uint32_t offset, uint32_t len, pb_image_stream_cb_t cb, void *user_data);
+
+#endif /* BOOT_SRC_IMAGE_H_ */
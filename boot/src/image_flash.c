@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "image.h"
+
+#include <errno.h>
+
+#include <zephyr/cache.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
+
+#define BUF_COUNT CONFIG_PB_FLASH_READ_BUF_COUNT
+#define BUF_SIZE  CONFIG_PB_FLASH_READ_BUF_SIZE
+
+static uint8_t bufs[BUF_COUNT][BUF_SIZE] __aligned(32);
+static const struct device *flash = DEVICE_DT_GET(DT_CHOSEN(zephyr_flash_controller));
+
+#ifdef CONFIG_PB_FLASH_READ_DMA
+static const struct device *dma = DEVICE_DT_GET(DT_CHOSEN(pb_flash_dma));
+static int dma_channel = -EINVAL;
+
+static struct {
+	/* next flash offset to fetch */
+	uint32_t offset;
+	/* bytes left to fetch */
+	uint32_t pending;
+	/* length of each buffer contents */
+	size_t len[BUF_COUNT];
+	/* next buffer to be filled */
+	uint8_t head;
+	/* buffers filled and not yet consumed */
+	uint8_t filled;
+	/* transfer in progress */
+	bool busy;
+	/* transfer error */
+	int err;
+	/* given on each completed transfer */
+	struct k_sem done;
+} rd;
+
+static void image_dma_fetch(void);
+
+static void image_dma_cb(const struct device *dev, void *user_data, uint32_t channel, int status)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+	ARG_UNUSED(channel);
+
+	rd.busy = false;
+
+	if (status < 0) {
+		rd.err = status;
+	} else {
+		rd.filled++;
+		rd.head = (rd.head + 1U) % BUF_COUNT;
+		image_dma_fetch();
+	}
+
+	k_sem_give(&rd.done);
+}
+
+/* must be called with interrupts locked or from the DMA callback */
+static void image_dma_fetch(void)
+{
+	struct dma_block_config blk = {0};
+	struct dma_config cfg = {0};
+	size_t len;
+	int ret;
+
+	if (rd.busy || (rd.err < 0) || (rd.pending == 0U) || (rd.filled == BUF_COUNT)) {
+		return;
+	}
+
+	len = MIN(BUF_SIZE, rd.pending);
+
+	blk.source_address = CONFIG_FLASH_BASE_ADDRESS + rd.offset;
+	blk.dest_address = (uintptr_t)bufs[rd.head];
+	blk.block_size = len;
+	blk.source_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+	blk.dest_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+
+	cfg.channel_direction = MEMORY_TO_MEMORY;
+	cfg.source_data_size = 1U;
+	cfg.dest_data_size = 1U;
+	cfg.source_burst_length = 1U;
+	cfg.dest_burst_length = 1U;
+	cfg.block_count = 1U;
+	cfg.head_block = &blk;
+	cfg.dma_callback = image_dma_cb;
+
+	ret = dma_config(dma, dma_channel, &cfg);
+	if (ret == 0) {
+		ret = dma_start(dma, dma_channel);
+	}
+
+	if (ret < 0) {
+		rd.err = ret;
+		k_sem_give(&rd.done);
+		return;
+	}
+
+	rd.len[rd.head] = len;
+	rd.offset += len;
+	rd.pending -= len;
+	rd.busy = true;
+}
+
+static int image_stream_dma(uint32_t offset, uint32_t len, pb_image_stream_cb_t cb,
+			    void *user_data)
+{
+	unsigned int key;
+	uint8_t tail = 0U;
+	int ret = 0;
+
+	rd.offset = offset;
+	rd.pending = len;
+	rd.head = 0U;
+	rd.filled = 0U;
+	rd.busy = false;
+	rd.err = 0;
+	k_sem_reset(&rd.done);
+
+	key = irq_lock();
+	image_dma_fetch();
+	irq_unlock(key);
+
+	while (len > 0U) {
+		size_t chunk;
+
+		(void)k_sem_take(&rd.done, K_FOREVER);
+
+		if (rd.err < 0) {
+			LOG_ERR("Failed to read from flash using DMA (err %d)", rd.err);
+			ret = rd.err;
+			break;
+		}
+
+		if (rd.filled == 0U) {
+			continue;
+		}
+
+		chunk = rd.len[tail];
+		(void)sys_cache_data_invd_range(bufs[tail], chunk);
+
+		ret = cb(bufs[tail], chunk, user_data);
+		if (ret < 0) {
+			break;
+		}
+
+		len -= chunk;
+		tail = (tail + 1U) % BUF_COUNT;
+
+		key = irq_lock();
+		rd.filled--;
+		image_dma_fetch();
+		irq_unlock(key);
+	}
+
+	if (ret < 0) {
+		(void)dma_stop(dma, dma_channel);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_PB_FLASH_READ_DMA */
+
+static int image_stream_sync(uint32_t offset, uint32_t len, pb_image_stream_cb_t cb,
+			     void *user_data)
+{
+	int ret;
+
+	while (len > 0U) {
+		size_t chunk = MIN(BUF_SIZE, len);
+
+		ret = flash_read(flash, offset, bufs[0], chunk);
+		if (ret < 0) {
+			LOG_ERR("Failed to read from flash (err %d)", ret);
+			return ret;
+		}
+
+		ret = cb(bufs[0], chunk, user_data);
+		if (ret < 0) {
+			return ret;
+		}
+
+		len -= chunk;
+		offset += chunk;
+	}
+
+	return 0;
+}
+
+int pb_image_init(void)
+{
+	if (!device_is_ready(flash)) {
+		LOG_ERR("Flash device not ready");
+		return -ENODEV;
+	}
+
+#ifdef CONFIG_PB_FLASH_READ_DMA
+	k_sem_init(&rd.done, 0, BUF_COUNT + 1U);
+
+	if (!device_is_ready(dma)) {
+		LOG_WRN("Flash DMA device not ready, using synchronous reads");
+		return 0;
+	}
+
+	dma_channel = dma_request_channel(dma, NULL);
+	if (dma_channel < 0) {
+		LOG_WRN("No DMA channel available, using synchronous reads");
+	}
+#endif
+
+	return 0;
+}
+
+int pb_image_read(uint32_t offset, void *dst, size_t len)
+{
+	int ret;
+
+	ret = flash_read(flash, offset, dst, len);
+	if (ret < 0) {
+		LOG_ERR("Failed to read from flash (err %d)", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+int pb_image_stream(uint32_t offset, uint32_t len, pb_image_stream_cb_t cb, void *user_data)
+{
+#ifdef CONFIG_PB_FLASH_READ_DMA
+	if (dma_channel >= 0) {
+		return image_stream_dma(offset, len, cb, user_data);
+	}
+#endif
+
+	return image_stream_sync(offset, len, cb, user_data);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "image.h"
+
+#include <string.h>
+
+#include <zephyr/cache.h>
+#include <zephyr/sys/util.h>
+
+static inline const uint8_t *image_mmap_ptr(uint32_t offset)
+{
+	return (const uint8_t *)(CONFIG_FLASH_BASE_ADDRESS + offset);
+}
+
+int pb_image_init(void)
+{
+	return 0;
+}
+
+int pb_image_read(uint32_t offset, void *dst, size_t len)
+{
+	const uint8_t *src = image_mmap_ptr(offset);
+
+	/* flash may have been written through the controller since cached */
+	(void)sys_cache_data_invd_range((void *)src, len);
+
+	memcpy(dst, src, len);
+
+	return 0;
+}
+
+int pb_image_stream(uint32_t offset, uint32_t len, pb_image_stream_cb_t cb, void *user_data)
+{
+	const uint8_t *src = image_mmap_ptr(offset);
+	int ret;
+
+	(void)sys_cache_data_invd_range((void *)src, len);
+
+	while (len > 0U) {
+		size_t chunk = MIN(CONFIG_PB_FLASH_READ_BUF_SIZE, len);
+
+		ret = cb(src, chunk, user_data);
+		if (ret < 0) {
+			return ret;
+		}
+
+		src += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
@@ -0,0 +1,951 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "firmware.h"
+#include "image.h"
+#include "install.h"
+#include "valcache.h"
+#include "watchdog.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include <pb/bootbit.h>
+#include <pb/crc.h>
+#include <pb/pack.h>
+
+LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
+
+#define SLOT0_ADDR   DT_REG_ADDR(DT_CHOSEN(pb_slot0))
+#define SLOT0_SIZE   DT_REG_SIZE(DT_CHOSEN(pb_slot0))
+#define SLOT1_ADDR   DT_REG_ADDR(DT_CHOSEN(pb_slot1))
+#define SLOT1_SIZE   DT_REG_SIZE(DT_CHOSEN(pb_slot1))
+#define PRF_ADDR     DT_REG_ADDR(DT_CHOSEN(pb_prf))
+#define PRF_SIZE     DT_REG_SIZE(DT_CHOSEN(pb_prf))
+#define STAGING_ADDR DT_REG_ADDR(DT_CHOSEN(pb_staging))
+#define STAGING_SIZE DT_REG_SIZE(DT_CHOSEN(pb_staging))
+
+#define BUF_SIZE     CONFIG_PB_INSTALL_BUF_SIZE
+/* maximum size of the image header area, written last */
+#define HDR_AREA_MAX 256U
+
+/* install journal magic ("PBJN") */
+#define JOURNAL_MAGIC 0x4e4a4250UL
+
+/*
+ * Install journal, stored in the last sector of the staging partition. It is
+ * followed by progress marks, one per write block, each programmed once a
+ * group of sectors has been installed.
+ */
+struct install_journal {
+	uint32_t magic;
+	uint32_t payload_crc;
+	uint32_t target;
+	uint32_t image_length;
+};
+
+static const struct device *flash = DEVICE_DT_GET(DT_CHOSEN(zephyr_flash_controller));
+
+static uint8_t in_buf[BUF_SIZE];
+static uint8_t out_buf[BUF_SIZE] __aligned(4);
+static uint8_t hdr_buf[HDR_AREA_MAX] __aligned(4);
+static uint8_t cmp_buf[256] __aligned(4);
+
+static struct {
+	/* payload flash offset and size */
+	uint32_t in_addr;
+	uint32_t in_len;
+	/* payload bytes read into in_buf so far */
+	uint32_t in_read;
+	/* in_buf consumed position and fill level */
+	size_t in_pos;
+	size_t in_fill;
+	/* image flash offset and size */
+	uint32_t out_addr;
+	uint32_t out_len;
+	/* image bytes produced so far */
+	uint32_t out_pos;
+	/* image bytes written to flash (or kept in hdr_buf) */
+	uint32_t out_flushed;
+	/* sectors already installed when resuming */
+	uint32_t resumed;
+	/* an interrupted install may be resumed */
+	bool resume;
+	/* PRF image validated, and about to be (or being) written */
+	bool staged;
+	/* journal started, to be cleared once the outcome is committed */
+	bool journal;
+	/* journal flash offset, marks offset and sectors per mark */
+	uint32_t journal_addr;
+	size_t marks_off;
+	uint32_t mark_every;
+	/* statistics */
+	uint32_t written;
+	uint32_t erased;
+	uint32_t unchanged;
+	/* image range programmed by this (or an interrupted) install */
+	uint32_t changed_start;
+	uint32_t changed_end;
+	/* flash geometry */
+	size_t erase_size;
+	size_t write_size;
+	size_t hdr_area;
+	uint8_t erase_value;
+} inst;
+
+static int install_crc_update(const uint8_t *data, size_t len, void *user_data)
+{
+	uint32_t *crc = user_data;
+
+	*crc = pb_crc32_ieee_update(*crc, data, len);
+
+	(void)pb_watchdog_feed();
+
+	return 0;
+}
+
+static int install_journal_find(const struct pb_pack_header *pack, uint32_t *target)
+{
+	struct install_journal jnl;
+	int ret;
+
+	ret = pb_image_read(inst.journal_addr, &jnl, sizeof(jnl));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if ((jnl.magic != JOURNAL_MAGIC) || (jnl.payload_crc != pack->payload_crc) ||
+	    (jnl.image_length != pack->image_length)) {
+		return -ENOENT;
+	}
+
+	*target = jnl.target;
+
+	return 0;
+}
+
+static void install_changed(uint32_t start, uint32_t end)
+{
+	inst.changed_start = MIN(inst.changed_start, start);
+	inst.changed_end = MAX(inst.changed_end, end);
+}
+
+static void install_resume(uint32_t sectors)
+{
+	/* sectors programmed before the interruption were never compared */
+	inst.resumed = sectors;
+	if (sectors > 0U) {
+		install_changed(0U, sectors * inst.erase_size);
+	}
+}
+
+static int install_journal_start(const struct pb_pack_header *pack)
+{
+	struct install_journal jnl;
+	uint32_t sectors;
+	uint32_t marks;
+	uint32_t target;
+	size_t n;
+	int ret;
+
+	sectors = DIV_ROUND_UP(inst.out_len, inst.erase_size);
+	inst.marks_off = ROUND_UP(sizeof(jnl), inst.write_size);
+	inst.mark_every = DIV_ROUND_UP(sectors, (inst.erase_size - inst.marks_off) /
+							inst.write_size);
+
+	/* resume an interrupted install of the same package */
+	if (inst.resume && (install_journal_find(pack, &target) == 0) &&
+	    (target == inst.out_addr)) {
+		marks = 0U;
+
+		for (uint32_t off = inst.marks_off; off < inst.erase_size; off += n) {
+			n = MIN(sizeof(cmp_buf), inst.erase_size - off);
+
+			ret = pb_image_read(inst.journal_addr + off, cmp_buf, n);
+			if (ret < 0) {
+				return ret;
+			}
+
+			for (size_t i = 0U; i < n; i += inst.write_size) {
+				if (cmp_buf[i] == inst.erase_value) {
+					install_resume(marks * inst.mark_every);
+					LOG_INF("Resuming install (%" PRIu32 "/%" PRIu32
+						" sectors)", inst.resumed, sectors);
+					return 0;
+				}
+
+				marks++;
+			}
+		}
+
+		install_resume(marks * inst.mark_every);
+		return 0;
+	}
+
+	ret = flash_erase(flash, inst.journal_addr, inst.erase_size);
+	if (ret < 0) {
+		return ret;
+	}
+
+	jnl.magic = JOURNAL_MAGIC;
+	jnl.payload_crc = pack->payload_crc;
+	jnl.target = inst.out_addr;
+	jnl.image_length = inst.out_len;
+
+	memset(cmp_buf, inst.erase_value, inst.marks_off);
+	memcpy(cmp_buf, &jnl, sizeof(jnl));
+
+	return flash_write(flash, inst.journal_addr, cmp_buf, inst.marks_off);
+}
+
+static int install_journal_mark(uint32_t sectors)
+{
+	uint32_t mark;
+
+	if ((sectors % inst.mark_every) != 0U) {
+		return 0;
+	}
+
+	mark = (sectors / inst.mark_every) - 1U;
+
+	memset(cmp_buf, (uint8_t)~inst.erase_value, inst.write_size);
+
+	return flash_write(flash, inst.journal_addr + inst.marks_off + (mark * inst.write_size),
+			   cmp_buf, inst.write_size);
+}
+
+static void install_journal_clear(void)
+{
+	int ret;
+
+	if (!inst.journal) {
+		return;
+	}
+
+	ret = flash_erase(flash, inst.journal_addr, inst.erase_size);
+	if (ret < 0) {
+		LOG_ERR("Failed to clear install journal (err %d)", ret);
+	}
+}
+
+/* program a sector, unless unchanged, and only erase it if needed */
+static int install_sector_program(uint32_t addr, const uint8_t *data, size_t len)
+{
+	bool unchanged = true;
+	bool blank = true;
+	size_t skip = 0U;
+	size_t n;
+	int ret;
+
+	for (size_t off = 0U; (off < len) && (unchanged || blank); off += n) {
+		n = MIN(sizeof(cmp_buf), len - off);
+
+		ret = pb_image_read(addr + off, cmp_buf, n);
+		if (ret < 0) {
+			return ret;
+		}
+
+		unchanged = unchanged && (memcmp(cmp_buf, &data[off], n) == 0);
+
+		for (size_t i = 0U; blank && (i < n); i++) {
+			blank = cmp_buf[i] == inst.erase_value;
+		}
+	}
+
+	if (unchanged) {
+		inst.unchanged++;
+		return 0;
+	}
+
+	if (!blank) {
+		ret = flash_erase(flash, addr, inst.erase_size);
+		if (ret < 0) {
+			LOG_ERR("Failed to erase 0x%" PRIx32 " (err %d)", addr, ret);
+			return ret;
+		}
+
+		inst.erased++;
+	}
+
+	/* the image header area is left erased, see install_flush() */
+	if (addr == inst.out_addr) {
+		skip = inst.hdr_area;
+	}
+
+	ret = flash_write(flash, addr + skip, &data[skip], len - skip);
+	if (ret < 0) {
+		LOG_ERR("Failed to write 0x%" PRIx32 " (err %d)", addr, ret);
+		return ret;
+	}
+
+	inst.written++;
+	install_changed(addr - inst.out_addr, addr - inst.out_addr + len);
+
+	return 0;
+}
+
+static int install_flush(void)
+{
+	size_t len = inst.out_pos - inst.out_flushed;
+	uint32_t sector;
+	size_t padded;
+	int ret;
+
+	if (len == 0U) {
+		return 0;
+	}
+
+	/* only the last chunk may need padding */
+	padded = ROUND_UP(len, inst.write_size);
+	memset(&out_buf[len], inst.erase_value, padded - len);
+
+	/* keep the image header, it is written once the image is validated */
+	if (inst.out_flushed == 0U) {
+		memcpy(hdr_buf, out_buf, inst.hdr_area);
+		memset(out_buf, inst.erase_value, inst.hdr_area);
+	}
+
+	for (size_t off = 0U; off < padded; off += inst.erase_size) {
+		sector = (inst.out_flushed + off) / inst.erase_size;
+
+		/* sectors installed before an interruption */
+		if (sector < inst.resumed) {
+			continue;
+		}
+
+		ret = install_sector_program(inst.out_addr + inst.out_flushed + off, &out_buf[off],
+					     MIN(inst.erase_size, padded - off));
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = install_journal_mark(sector + 1U);
+		if (ret < 0) {
+			return ret;
+		}
+
+		(void)pb_watchdog_feed();
+	}
+
+	inst.out_flushed += len;
+
+	return 0;
+}
+
+static inline int install_out_put(uint8_t b)
+{
+	out_buf[inst.out_pos - inst.out_flushed] = b;
+	inst.out_pos++;
+
+	if ((inst.out_pos - inst.out_flushed) == BUF_SIZE) {
+		return install_flush();
+	}
+
+	return 0;
+}
+
+static int install_in_fill(void)
+{
+	size_t len;
+	int ret;
+
+	len = MIN(BUF_SIZE, inst.in_len - inst.in_read);
+	if (len == 0U) {
+		/* truncated payload */
+		return -EINVAL;
+	}
+
+	ret = pb_image_read(inst.in_addr + inst.in_read, in_buf, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	inst.in_read += len;
+	inst.in_pos = 0U;
+	inst.in_fill = len;
+
+	return 0;
+}
+
+int pb_install_in_get(uint8_t *b)
+{
+	int ret;
+
+	if (inst.in_pos == inst.in_fill) {
+		ret = install_in_fill();
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	*b = in_buf[inst.in_pos++];
+
+	return 0;
+}
+
+int pb_install_in_read(void *dst, size_t len)
+{
+	uint8_t *p = dst;
+	int ret;
+
+	for (size_t i = 0U; i < len; i++) {
+		ret = pb_install_in_get(&p[i]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+bool pb_install_in_done(void)
+{
+	return (inst.in_pos == inst.in_fill) && (inst.in_read == inst.in_len);
+}
+
+int pb_install_in_copy(uint32_t len)
+{
+	size_t n;
+	int ret;
+
+	if (len > (inst.out_len - inst.out_pos)) {
+		return -EINVAL;
+	}
+
+	while (len > 0U) {
+		if (inst.in_pos == inst.in_fill) {
+			ret = install_in_fill();
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		n = MIN(len, inst.in_fill - inst.in_pos);
+		n = MIN(n, BUF_SIZE - (inst.out_pos - inst.out_flushed));
+
+		memcpy(&out_buf[inst.out_pos - inst.out_flushed], &in_buf[inst.in_pos], n);
+		inst.in_pos += n;
+		inst.out_pos += n;
+		len -= n;
+
+		if ((inst.out_pos - inst.out_flushed) == BUF_SIZE) {
+			ret = install_flush();
+			if (ret < 0) {
+				return ret;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int pb_install_out_copy(uint32_t distance, uint32_t len)
+{
+	uint32_t src;
+	size_t n;
+	int ret;
+
+	if ((distance == 0U) || (distance > inst.out_pos) ||
+	    (len > (inst.out_len - inst.out_pos))) {
+		return -EINVAL;
+	}
+
+	while (len > 0U) {
+		src = inst.out_pos - distance;
+
+		if (src >= inst.out_flushed) {
+			/* still in RAM */
+			ret = install_out_put(out_buf[src - inst.out_flushed]);
+			len--;
+		} else if (src < inst.hdr_area) {
+			ret = install_out_put(hdr_buf[src]);
+			len--;
+		} else {
+			/* already written, read back from flash */
+			n = MIN(len, inst.out_flushed - src);
+			n = MIN(n, BUF_SIZE - (inst.out_pos - inst.out_flushed));
+
+			ret = pb_image_read(inst.out_addr + src,
+					    &out_buf[inst.out_pos - inst.out_flushed], n);
+			if (ret < 0) {
+				return ret;
+			}
+
+			inst.out_pos += n;
+			len -= n;
+
+			if ((inst.out_pos - inst.out_flushed) == BUF_SIZE) {
+				ret = install_flush();
+			}
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int pb_install_flash_copy(uint32_t addr, uint32_t len)
+{
+	size_t n;
+	int ret;
+
+	if (len > (inst.out_len - inst.out_pos)) {
+		return -EINVAL;
+	}
+
+	while (len > 0U) {
+		n = MIN(len, BUF_SIZE - (inst.out_pos - inst.out_flushed));
+
+		ret = pb_image_read(addr, &out_buf[inst.out_pos - inst.out_flushed], n);
+		if (ret < 0) {
+			return ret;
+		}
+
+		addr += n;
+		inst.out_pos += n;
+		len -= n;
+
+		if ((inst.out_pos - inst.out_flushed) == BUF_SIZE) {
+			ret = install_flush();
+			if (ret < 0) {
+				return ret;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static void install_slot_get(uint8_t *slot)
+{
+	uint8_t booted;
+
+	/*
+	 * never overwrite the image that would be booted: a newer slot with a
+	 * valid header may still be corrupted, so selection must be validated
+	 */
+	if ((pb_firmware_select() == 0) && (pb_firmware_selected_slot(&booted) == 0)) {
+		*slot = 1U - booted;
+	} else {
+		*slot = 0U;
+	}
+}
+
+static int install_flash_init(void)
+{
+	const struct flash_parameters *params;
+	struct flash_pages_info info;
+	int ret;
+
+	if (!device_is_ready(flash)) {
+		return -ENODEV;
+	}
+
+	ret = flash_get_page_info_by_offs(flash, STAGING_ADDR + STAGING_SIZE - 1U, &info);
+	if (ret < 0) {
+		return ret;
+	}
+
+	params = flash_get_parameters(flash);
+
+	inst.erase_size = info.size;
+	inst.write_size = flash_get_write_block_size(flash);
+	inst.erase_value = params->erase_value;
+	inst.hdr_area = ROUND_UP(PBLBOOT_HEADER_V1_LENGTH, inst.write_size);
+	inst.journal_addr = info.start_offset;
+
+	if (((BUF_SIZE % inst.erase_size) != 0U) || (inst.write_size > sizeof(cmp_buf)) ||
+	    (inst.hdr_area > HDR_AREA_MAX)) {
+		LOG_ERR("Unsupported flash geometry (erase %zu, write %zu)", inst.erase_size,
+			inst.write_size);
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+static int install_decode(const struct pb_pack_header *pack)
+{
+	switch (pack->encoding) {
+	case PB_PACK_ENCODING_RAW:
+		return pb_install_in_copy(inst.in_len);
+#ifdef CONFIG_PB_INSTALL_LZ4
+	case PB_PACK_ENCODING_LZ4:
+		return pb_install_lz4_decode();
+#endif
+#ifdef CONFIG_PB_INSTALL_DELTA
+	case PB_PACK_ENCODING_DELTA:
+		/* source is the other, active, slot */
+		return (inst.out_addr == SLOT0_ADDR)
+			       ? pb_install_delta_decode(SLOT1_ADDR, SLOT1_SIZE)
+			       : pb_install_delta_decode(SLOT0_ADDR, SLOT0_SIZE);
+#endif
+	default:
+		LOG_ERR("Unsupported package encoding (%" PRIu8 ")", pack->encoding);
+		return -ENOTSUP;
+	}
+}
+
+static int install_finish(void)
+{
+	struct firmware_header hdr;
+	uint32_t start;
+	uint32_t end;
+	int ret;
+
+	/* only the v1 part of the header is kept back, the rest is in flash */
+	ret = pb_image_read(inst.out_addr, &hdr, sizeof(hdr));
+	if (ret < 0) {
+		return ret;
+	}
+
+	memcpy(&hdr, hdr_buf, MIN(inst.hdr_area, sizeof(hdr)));
+
+	/* validate image before making it bootable by writing its header */
+	if ((pb_firmware_header_check(&hdr, inst.out_len) < 0) ||
+	    (hdr.start_offset < inst.hdr_area) ||
+	    ((hdr.block_size != 0U) && (hdr.table_offset < inst.hdr_area))) {
+		LOG_ERR("Invalid image header");
+		return -EINVAL;
+	}
+
+	(void)pb_watchdog_feed();
+
+	/*
+	 * sectors left unchanged were compared with the decoded image, so only
+	 * the blocks that were programmed need to be checked (v2 header only)
+	 */
+	start = MAX(inst.changed_start, hdr.start_offset) - hdr.start_offset;
+	end = MAX(inst.changed_end, hdr.start_offset) - hdr.start_offset;
+	end = MAX(end, start);
+
+	ret = pb_firmware_validate_range(inst.out_addr, &hdr, start, end - start);
+	if (ret < 0) {
+		LOG_ERR("Installed image is corrupted (err %d)", ret);
+		return ret;
+	}
+
+	(void)pb_watchdog_feed();
+
+	/* header may already be there if interrupted right after writing it */
+	ret = pb_image_read(inst.out_addr, cmp_buf, inst.hdr_area);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (memcmp(cmp_buf, hdr_buf, inst.hdr_area) == 0) {
+		return 0;
+	}
+
+	ret = flash_write(flash, inst.out_addr, hdr_buf, inst.hdr_area);
+	if (ret < 0) {
+		LOG_ERR("Failed to write image header (err %d)", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+static void install_out_init(uint32_t addr)
+{
+	inst.out_addr = addr;
+	inst.out_pos = 0U;
+	inst.out_flushed = 0U;
+	inst.resumed = 0U;
+	inst.written = 0U;
+	inst.erased = 0U;
+	inst.unchanged = 0U;
+	inst.changed_start = UINT32_MAX;
+	inst.changed_end = 0U;
+}
+
+/* produce the image at inst.out_addr, by decoding the package or copying src */
+static int install_image(const struct pb_pack_header *pack, bool decode, uint32_t src)
+{
+	int ret;
+
+	ret = install_journal_start(pack);
+	if (ret < 0) {
+		LOG_ERR("Failed to start install journal (err %d)", ret);
+		return ret;
+	}
+
+	inst.journal = true;
+
+	if (decode) {
+		ret = install_decode(pack);
+		if ((ret == 0) && !pb_install_in_done()) {
+			ret = -EINVAL;
+		}
+	} else {
+		ret = pb_install_flash_copy(src, inst.out_len);
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Failed to decode package (err %d)", ret);
+		return ret;
+	}
+
+	if (inst.out_pos != inst.out_len) {
+		LOG_ERR("Package size mismatch");
+		return -EINVAL;
+	}
+
+	ret = install_flush();
+	if (ret == 0) {
+		ret = install_finish();
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	LOG_INF("Image written to 0x%" PRIx32 " (sectors: %" PRIu32 " written, %" PRIu32
+		" erased, %" PRIu32 " unchanged, %" PRIu32 " resumed)",
+		inst.out_addr, inst.written, inst.erased, inst.unchanged, inst.resumed);
+
+	return 0;
+}
+
+/*
+ * Get a validated copy of the PRF image outside of the PRF partition: the
+ * payload itself for raw packages, or the image decoded in the staging
+ * partition, right after the package, otherwise.
+ */
+static int install_prf_stage(const struct pb_pack_header *pack, uint32_t *src)
+{
+	struct firmware_header hdr;
+	uint32_t scratch;
+	int ret;
+
+	if (pack->encoding == PB_PACK_ENCODING_RAW) {
+		if (inst.in_len != inst.out_len) {
+			LOG_ERR("Package size mismatch");
+			return -EINVAL;
+		}
+
+		ret = pb_firmware_header_get(inst.in_addr, inst.out_len, &hdr);
+		if (ret < 0) {
+			LOG_ERR("Invalid image header");
+			return ret;
+		}
+
+		*src = inst.in_addr;
+
+		return pb_firmware_validate(inst.in_addr, &hdr);
+	}
+
+	scratch = ROUND_UP(inst.in_addr + inst.in_len, inst.erase_size);
+	if ((scratch + ROUND_UP(inst.out_len, inst.erase_size)) > inst.journal_addr) {
+		LOG_ERR("No room to decode PRF package in staging partition");
+		return -ENOSPC;
+	}
+
+	/* header and digests are checked before writing its header */
+	install_out_init(scratch);
+
+	ret = install_image(pack, true, 0U);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*src = scratch;
+
+	return 0;
+}
+
+static int install_package(bool prf, bool resume)
+{
+	struct pb_pack_header pack;
+	struct flash_pages_info info;
+	uint32_t out_addr;
+	uint32_t out_size;
+	uint32_t target;
+	uint32_t src;
+	uint32_t crc;
+	uint8_t slot;
+	int ret;
+
+	memset(&inst, 0, sizeof(inst));
+	inst.resume = resume;
+
+	ret = install_flash_init();
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = pb_image_read(STAGING_ADDR, &pack, sizeof(pack));
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* the last staging sector holds the install journal */
+	if ((pack.magic != PB_PACK_MAGIC) || (pack.header_length != sizeof(pack)) ||
+	    (pack.version != PB_PACK_VERSION) ||
+	    (pack.payload_length > (inst.journal_addr - STAGING_ADDR - sizeof(pack)))) {
+		LOG_ERR("Invalid package header");
+		return -EINVAL;
+	}
+
+	/* do not touch the target if the package is corrupted */
+	crc = pb_crc32_ieee(NULL, 0U);
+	ret = pb_image_stream(STAGING_ADDR + sizeof(pack), pack.payload_length,
+			      install_crc_update, &crc);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (crc != pack.payload_crc) {
+		LOG_ERR("Package payload corrupted");
+		return -EIO;
+	}
+
+	if (prf) {
+		/* there is no other PRF image to apply a delta to */
+		if (pack.encoding == PB_PACK_ENCODING_DELTA) {
+			LOG_ERR("Delta packages not supported for PRF");
+			return -ENOTSUP;
+		}
+
+		out_addr = PRF_ADDR;
+		out_size = PRF_SIZE;
+	} else {
+		/* keep the target of an interrupted install */
+		if (inst.resume && (install_journal_find(&pack, &target) == 0) &&
+		    ((target == SLOT0_ADDR) || (target == SLOT1_ADDR))) {
+			slot = (target == SLOT0_ADDR) ? 0U : 1U;
+		} else {
+			install_slot_get(&slot);
+		}
+
+		out_addr = (slot == 0U) ? SLOT0_ADDR : SLOT1_ADDR;
+		out_size = (slot == 0U) ? SLOT0_SIZE : SLOT1_SIZE;
+	}
+
+	/* sectors are programmed using the staging sector size */
+	ret = flash_get_page_info_by_offs(flash, out_addr, &info);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (info.size != inst.erase_size) {
+		LOG_ERR("Unsupported flash geometry (erase %zu)", info.size);
+		return -ENOTSUP;
+	}
+
+	inst.in_addr = STAGING_ADDR + sizeof(pack);
+	inst.in_len = pack.payload_length;
+	inst.out_len = pack.image_length;
+
+	if ((inst.out_len < PBLBOOT_HEADER_V1_LENGTH) || (inst.out_len > out_size)) {
+		LOG_ERR("Invalid image size (%" PRIu32 ")", inst.out_len);
+		return -EINVAL;
+	}
+
+	LOG_INF("Installing package (encoding %" PRIu8 ", %" PRIu32 " bytes) to 0x%" PRIx32,
+		pack.encoding, pack.payload_length, out_addr);
+
+	/* cached validation results do not hold across bootloader flash writes */
+	pb_valcache_flash_written();
+
+	if (prf) {
+		/* the only recovery image is replaced once its successor is known good */
+		ret = install_prf_stage(&pack, &src);
+		if (ret < 0) {
+			LOG_ERR("PRF image rejected (err %d)", ret);
+			return ret;
+		}
+
+		inst.staged = true;
+		install_out_init(out_addr);
+
+		ret = install_image(&pack, false, src);
+	} else {
+		install_out_init(out_addr);
+
+		ret = install_image(&pack, true, 0U);
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	LOG_INF("Package installed");
+
+	return 0;
+}
+
+static int install(enum pb_bootbit available, bool prf)
+{
+	bool resume = true;
+	int ret;
+
+	if (!pb_bootbit_tst(available)) {
+		return 0;
+	}
+
+	if (!prf) {
+		/* a journal left by a completed install must not be resumed */
+		resume = pb_bootbit_tst(PB_BOOTBIT_NEW_FW_UPDATE_IN_PROGRESS);
+
+		pb_bootbit_set(PB_BOOTBIT_NEW_FW_UPDATE_IN_PROGRESS);
+		pb_bootbit_commit();
+	}
+
+	ret = install_package(prf, resume);
+
+	/*
+	 * do not retry a rejected package on every boot, an interrupted install
+	 * is resumed as the bootbits are left untouched. A PRF that could not
+	 * be written after its replacement was validated is retried, as the
+	 * staged package is then the only good recovery image left.
+	 */
+	if ((ret == 0) || !prf || !inst.staged) {
+		pb_bootbit_clr(available);
+	}
+
+	if (!prf) {
+		pb_bootbit_clr(PB_BOOTBIT_NEW_FW_UPDATE_IN_PROGRESS);
+		if (ret == 0) {
+			pb_bootbit_set(PB_BOOTBIT_NEW_FW_INSTALLED);
+		}
+	}
+
+	pb_bootbit_commit();
+
+	/*
+	 * the journal is only dropped once the outcome is committed, so that
+	 * power loss in between resumes (and completes) the same install
+	 */
+	install_journal_clear();
+
+	return ret;
+}
+
+int pb_install_firmware(void)
+{
+	return install(PB_BOOTBIT_NEW_FW_AVAILABLE, false);
+}
+
+int pb_install_prf(void)
+{
+	return install(PB_BOOTBIT_NEW_PRF_AVAILABLE, true);
+}
+
+bool pb_install_pending(void)
+{
+	return pb_bootbit_tst(PB_BOOTBIT_NEW_FW_AVAILABLE) ||
+	       pb_bootbit_tst(PB_BOOTBIT_NEW_PRF_AVAILABLE);
+}
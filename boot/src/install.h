@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file install.h
+ * @brief Firmware installation for pblboot.
+ *
+ * Installs firmware packages staged by the firmware (see pb/pack.h) into the
+ * inactive firmware slot, that is the slot with no valid image or with the
+ * oldest one, or into the PRF partition. Delta packages use the image in the
+ * other slot as source. The payload is decoded in a streaming fashion with
+ * fixed size buffers and the target is programmed sector by sector: sectors
+ * already holding the expected contents are skipped, and only sectors that are
+ * not blank are erased. The image header is written last, once the image has
+ * been validated. The regular firmware load path then boots it.
+ *
+ * Installs are power-fail safe: progress is recorded in a journal kept in the
+ * last sector of the staging partition, so that an interrupted install is
+ * resumed on the next boot from the last recorded sector.
+ */
+
+#ifndef BOOT_SRC_INSTALL_H_
+#define BOOT_SRC_INSTALL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef CONFIG_PB_INSTALL
+
+/**
+ * @brief Install staged firmware, if requested.
+ *
+ * Nothing is done unless the NEW_FW_AVAILABLE bootbit is set. The bootbit is
+ * cleared once the package has been processed, and NEW_FW_INSTALLED is set on
+ * success.
+ *
+ * @retval 0 on success, or if there was nothing to install
+ * @retval -errno negative error code on failure
+ */
+int pb_install_firmware(void);
+
+/**
+ * @brief Install staged PRF, if requested.
+ *
+ * Nothing is done unless the NEW_PRF_AVAILABLE bootbit is set. The bootbit is
+ * cleared once the package has been processed. Delta packages are not
+ * supported.
+ *
+ * @retval 0 on success, or if there was nothing to install
+ * @retval -errno negative error code on failure
+ */
+int pb_install_prf(void);
+
+/**
+ * @brief Check if a staged firmware or PRF install is requested.
+ *
+ * @retval true if pb_install_firmware() or pb_install_prf() will write flash
+ * @retval false otherwise
+ */
+bool pb_install_pending(void);
+
+/**
+ * @name Payload decoder interface
+ *
+ * Payload decoders consume the payload and produce the image through these
+ * functions, all of which return 0 on success or a negative error code.
+ * @{
+ */
+
+/**
+ * @brief Get the next payload byte.
+ *
+ * @param[out] b Payload byte.
+ */
+int pb_install_in_get(uint8_t *b);
+
+/**
+ * @brief Read payload bytes.
+ *
+ * @param[out] dst Destination buffer.
+ * @param len Number of bytes.
+ */
+int pb_install_in_read(void *dst, size_t len);
+
+/**
+ * @brief Check if the whole payload has been consumed.
+ *
+ * @retval true if the whole payload has been consumed
+ * @retval false otherwise
+ */
+bool pb_install_in_done(void);
+
+/**
+ * @brief Copy payload bytes to the image.
+ *
+ * @param len Number of bytes.
+ */
+int pb_install_in_copy(uint32_t len);
+
+/**
+ * @brief Copy already produced image bytes to the image.
+ *
+ * Source and destination may overlap, bytes are copied in order.
+ *
+ * @param distance Distance back from the current image position.
+ * @param len Number of bytes.
+ */
+int pb_install_out_copy(uint32_t distance, uint32_t len);
+
+/**
+ * @brief Copy flash contents (e.g. from another slot) to the image.
+ *
+ * @param addr Flash offset.
+ * @param len Number of bytes.
+ */
+int pb_install_flash_copy(uint32_t addr, uint32_t len);
+
+/** @} */
+
+#ifdef CONFIG_PB_INSTALL_LZ4
+/**
+ * @brief Decode an LZ4 payload.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int pb_install_lz4_decode(void);
+#endif
+
+#ifdef CONFIG_PB_INSTALL_DELTA
+/**
+ * @brief Decode a delta payload.
+ *
+ * @param src_addr Source image flash offset.
+ * @param src_size Source slot size.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int pb_install_delta_decode(uint32_t src_addr, uint32_t src_size);
+#endif
+
+#else
+
+static inline int pb_install_firmware(void)
+{
+	return 0;
+}
+
+static inline int pb_install_prf(void)
+{
+	return 0;
+}
+
+static inline bool pb_install_pending(void)
+{
+	return false;
+}
+
+#endif /* CONFIG_PB_INSTALL */
+
+#endif /* BOOT_SRC_INSTALL_H_ */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "image.h"
+#include "install.h"
+#include "watchdog.h"
+
+#include <errno.h>
+
+#include <zephyr/logging/log.h>
+
+#include <pb/crc.h>
+#include <pb/pack.h>
+
+LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
+
+static int delta_crc_update(const uint8_t *data, size_t len, void *user_data)
+{
+	uint32_t *crc = user_data;
+
+	*crc = pb_crc32_ieee_update(*crc, data, len);
+
+	(void)pb_watchdog_feed();
+
+	return 0;
+}
+
+static int delta_uleb128_get(uint32_t *val)
+{
+	uint8_t b;
+	int ret;
+
+	*val = 0U;
+
+	for (uint8_t shift = 0U; shift < 32U; shift += 7U) {
+		ret = pb_install_in_get(&b);
+		if (ret < 0) {
+			return ret;
+		}
+
+		*val |= (uint32_t)(b & 0x7FU) << shift;
+		if ((b & 0x80U) == 0U) {
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+int pb_install_delta_decode(uint32_t src_addr, uint32_t src_size)
+{
+	struct pb_pack_delta_header hdr;
+	uint32_t src_pos = 0U;
+	uint32_t len;
+	uint32_t adj;
+	uint32_t crc;
+	uint8_t op;
+	int ret;
+
+	ret = pb_install_in_read(&hdr, sizeof(hdr));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (hdr.source_length > src_size) {
+		return -EINVAL;
+	}
+
+	/* the delta only applies to the exact source image it was built against */
+	crc = pb_crc32_ieee(NULL, 0U);
+	ret = pb_image_stream(src_addr, hdr.source_length, delta_crc_update, &crc);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (crc != hdr.source_crc) {
+		LOG_ERR("Delta source image mismatch");
+		return -ENOENT;
+	}
+
+	while (!pb_install_in_done()) {
+		ret = pb_install_in_get(&op);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = delta_uleb128_get(&len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		switch (op) {
+		case PB_PACK_DELTA_OP_LITERAL:
+			ret = pb_install_in_copy(len);
+			break;
+		case PB_PACK_DELTA_OP_COPY:
+			ret = delta_uleb128_get(&adj);
+			if (ret < 0) {
+				break;
+			}
+
+			/* zigzag decoding, wraps around like the encoder */
+			src_pos += (adj >> 1) ^ (uint32_t)-(int32_t)(adj & 1U);
+			if ((src_pos > hdr.source_length) ||
+			    (len > (hdr.source_length - src_pos))) {
+				ret = -EINVAL;
+				break;
+			}
+
+			ret = pb_install_flash_copy(src_addr + src_pos, len);
+			src_pos += len;
+			break;
+		default:
+			ret = -EINVAL;
+			break;
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "install.h"
+
+#include <errno.h>
+
+#define LZ4_MIN_MATCH 4U
+#define LZ4_LEN_MASK  0x0FU
+
+/* read an extended length, made of bytes until one is not 255 */
+static int lz4_len_get(uint32_t *len)
+{
+	uint8_t b;
+	int ret;
+
+	do {
+		ret = pb_install_in_get(&b);
+		if (ret < 0) {
+			return ret;
+		}
+
+		*len += b;
+	} while (b == 0xFFU);
+
+	return 0;
+}
+
+int pb_install_lz4_decode(void)
+{
+	uint32_t distance;
+	uint32_t len;
+	uint8_t token;
+	uint8_t b;
+	int ret;
+
+	while (!pb_install_in_done()) {
+		ret = pb_install_in_get(&token);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* literals */
+		len = token >> 4;
+		if (len == LZ4_LEN_MASK) {
+			ret = lz4_len_get(&len);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		ret = pb_install_in_copy(len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* last sequence has no match */
+		if (pb_install_in_done()) {
+			break;
+		}
+
+		/* match */
+		ret = pb_install_in_get(&b);
+		if (ret < 0) {
+			return ret;
+		}
+
+		distance = b;
+
+		ret = pb_install_in_get(&b);
+		if (ret < 0) {
+			return ret;
+		}
+
+		distance |= (uint32_t)b << 8;
+
+		len = token & LZ4_LEN_MASK;
+		if (len == LZ4_LEN_MASK) {
+			ret = lz4_len_get(&len);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		ret = pb_install_out_copy(distance, len + LZ4_MIN_MATCH);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
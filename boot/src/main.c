@@ -3,15 +3,22 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "bootlog.h"
+#include "bootstate.h"
+#include "boottask.h"
+#include "boottime.h"
 #include "buttons.h"
 #include "charger.h"
 #include "firmware.h"
+#include "install.h"
 #include "panic.h"
 #include "watchdog.h"
 
+#include <errno.h>
 #include <inttypes.h>
 
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
 
 #include <pb/bootbit.h>
 
@@ -19,54 +26,126 @@
 
 LOG_MODULE_REGISTER(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
 
+static int charger_check(void)
+{
+	return pb_charger_allow_boot() ? 0 : -EACCES;
+}
+
+PB_BOOTTASK_DEFINE(watchdog_init, pb_watchdog_init);
+PB_BOOTTASK_DEFINE(charger_init, pb_charger_init);
+PB_BOOTTASK_DEFINE(charger, charger_check, &charger_init);
+PB_BOOTTASK_DEFINE(firmware_init, pb_firmware_init);
+PB_BOOTTASK_DEFINE(firmware_select, pb_firmware_select, &watchdog_init, &firmware_init);
+
+/*
+ * check, without altering the bootbits, if this boot may end up in PRF (or in
+ * a panic) rather than in firmware
+ */
+static bool prf_possible(void)
+{
+	return pb_bootbit_tst(PB_BOOTBIT_FORCE_PRF) ||
+	       (pb_bootbit_reset_loop_cnt_get() == PB_BOOTBIT_RESET_LOOP_CNT_MAX) ||
+	       (!pb_bootbit_tst(PB_BOOTBIT_FW_STABLE) &&
+		pb_bootbit_tst(PB_BOOTBIT_SOFTWARE_FAILURE_OCCURRED));
+}
+
+/* firmware validation must be over before flash, or boot state, is used */
+static void firmware_select_sync(void)
+{
+	if (pb_boottask_submitted(&firmware_select)) {
+		(void)pb_boottask_wait(&firmware_select);
+	}
+}
+
+static void FUNC_NORETURN boot_panic(pb_panic_reason_t reason)
+{
+	firmware_select_sync();
+	pb_panic(reason);
+}
+
 int main(void)
 {
 	uint8_t rst_loop_cnt;
 	bool prf_requested = false;
 	int ret;
 
+	pb_boottime_init();
+
 	LOG_INF("PebbleOS bootloader %s", APP_VERSION_STRING);
 
 	pb_bootbit_init();
 
+	pb_bootlog_init();
+
+	ret = pb_bootstate_init();
+	if (ret < 0) {
+		LOG_ERR("Failed to initialize boot state (err %d)", ret);
+	}
+
+	pb_boottime_mark(PB_BOOTTIME_MARK_BOOTBIT_INIT);
+
 	ret = pb_buttons_init();
 	if (ret < 0) {
 		LOG_ERR("Failed to initialize buttons module (err %d)", ret);
 		return 0;
 	}
 
+	/* track the PRF button combo while booting, decided before loading firmware */
+	ret = pb_buttons_prf_arm();
+	if (ret < 0) {
+		LOG_ERR("Failed to arm PRF button combo (err %d)", ret);
+	}
+
 	pb_panic_init();
 
-	ret = pb_watchdog_init();
+	pb_boottask_submit(&watchdog_init);
+	pb_boottask_submit(&charger_init);
+	pb_boottask_submit(&charger);
+	pb_boottask_submit(&firmware_init);
+
+	/*
+	 * validate firmware ahead of the boot decision, unless flash is about to
+	 * be written, or firmware may not be booted at all
+	 */
+	if (!pb_install_pending() && !prf_possible()) {
+		pb_boottask_submit(&firmware_select);
+	}
+
+	ret = pb_boottask_wait(&watchdog_init);
 	if (ret < 0) {
 		LOG_ERR("Failed to initialize watchdog module (err %d)", ret);
-		pb_panic(PB_PANIC_REASON_INIT_FAIL);
+		boot_panic(PB_PANIC_REASON_INIT_FAIL);
 	}
 
-	ret = pb_charger_init();
+	ret = pb_boottask_wait(&charger_init);
 	if (ret < 0) {
 		LOG_ERR("Failed to initialize charger module (err %d)", ret);
-		pb_panic(PB_PANIC_REASON_INIT_FAIL);
+		boot_panic(PB_PANIC_REASON_INIT_FAIL);
 	}
 
-	ret = pb_firmware_init();
+	ret = pb_boottask_wait(&firmware_init);
 	if (ret < 0) {
 		LOG_ERR("Failed to initialize firmware module (err %d)", ret);
-		pb_panic(PB_PANIC_REASON_INIT_FAIL);
+		boot_panic(PB_PANIC_REASON_INIT_FAIL);
 	}
 
+	pb_boottime_mark(PB_BOOTTIME_MARK_PERIPH_INIT);
+
 	/* check battery/plugged in status to allow booting or not */
-	if (!pb_charger_allow_boot()) {
+	if (pb_boottask_wait(&charger) < 0) {
 		LOG_ERR("Boot not allowed: battery too low and plugged in");
-		pb_panic(PB_PANIC_REASON_BATTERY_LOW);
+		boot_panic(PB_PANIC_REASON_BATTERY_LOW);
 	}
 
+	pb_boottime_mark(PB_BOOTTIME_MARK_CHARGER);
+
 	/* reset loop counter handling */
 	rst_loop_cnt = pb_bootbit_reset_loop_cnt_get();
 	if (rst_loop_cnt == PB_BOOTBIT_RESET_LOOP_CNT_MAX) {
 		LOG_ERR("Reset loop detected");
+		pb_bootstate_reason(PB_BOOTSTATE_REASON_RESET_LOOP);
 		pb_bootbit_reset_loop_cnt_set(0U);
-		pb_panic(PB_PANIC_REASON_RESET_LOOP);
+		boot_panic(PB_PANIC_REASON_RESET_LOOP);
 	} else {
 		rst_loop_cnt++;
 		pb_bootbit_reset_loop_cnt_set(rst_loop_cnt);
@@ -75,6 +154,7 @@ int main(void)
 	/* firmware/PRF start failures */
 	if (pb_bootbit_fw_stable_tst_and_clr()) {
 		LOG_INF("Last firmware or PRF boot was stable; clear strikes");
+		pb_bootstate_reason(PB_BOOTSTATE_REASON_STABLE);
 
 		pb_bootbit_fw_fail_cnt_set(0U);
 		pb_bootbit_prf_fail_cnt_set(0U);
@@ -87,9 +167,11 @@ int main(void)
 				PB_BOOTBIT_PRF_FAIL_CNT_MAX);
 
 			if (cnt == PB_BOOTBIT_PRF_FAIL_CNT_MAX) {
+				pb_bootstate_reason(PB_BOOTSTATE_REASON_PRF_STRIKES);
 				pb_bootbit_prf_fail_cnt_set(0U);
-				pb_panic(PB_PANIC_REASON_PRF_UNSTABLE);
+				boot_panic(PB_PANIC_REASON_PRF_UNSTABLE);
 			} else {
+				pb_bootstate_reason(PB_BOOTSTATE_REASON_PRF_FAIL);
 				cnt++;
 				pb_bootbit_prf_fail_cnt_set(cnt);
 				prf_requested = true;
@@ -100,33 +182,70 @@ int main(void)
 				cnt, PB_BOOTBIT_FW_FAIL_CNT_MAX);
 
 			if (cnt == PB_BOOTBIT_FW_FAIL_CNT_MAX) {
+				pb_bootstate_reason(PB_BOOTSTATE_REASON_FW_STRIKES);
 				pb_bootbit_fw_fail_cnt_set(0U);
 				prf_requested = true;
 			} else {
+				pb_bootstate_reason(PB_BOOTSTATE_REASON_FW_FAIL);
 				cnt++;
 				pb_bootbit_fw_fail_cnt_set(cnt);
 			}
 		}
 	}
 
-	/* prf manual requests */
+	/* prf manual requests (buttons are checked once firmware is validated) */
+	if (!prf_requested && pb_bootbit_force_prf_tst_and_clr()) {
+		LOG_INF("Forced PRF load requested");
+		pb_bootstate_reason(PB_BOOTSTATE_REASON_PRF_FORCED);
+		prf_requested = true;
+	}
+
+	/* persist boot state (e.g. reset loop counter) before loading firmware */
+	pb_bootbit_commit();
+
+	pb_boottime_mark(PB_BOOTTIME_MARK_BOOT_STATE);
+
+	/* install staged PRF and firmware, if any */
+	ret = pb_install_prf();
+	if (ret < 0) {
+		LOG_ERR("Failed to install PRF (err %d)", ret);
+	}
+
+	if (!prf_requested) {
+		ret = pb_install_firmware();
+		if (ret < 0) {
+			LOG_ERR("Failed to install firmware (err %d)", ret);
+		}
+	}
+
+	/* validate firmware while the PRF button combo is being held */
 	if (!prf_requested) {
-		if (pb_bootbit_force_prf_tst_and_clr()) {
-			LOG_INF("Forced PRF load requested");
-			prf_requested = true;
-		} else if (pb_buttons_prf_requested()) {
+		if (!pb_boottask_submitted(&firmware_select)) {
+			pb_boottask_submit(&firmware_select);
+		}
+
+		/* no valid firmware is handled by pb_firmware_load() */
+		(void)pb_boottask_wait(&firmware_select);
+
+		if (pb_buttons_prf_requested()) {
+			pb_bootstate_reason(PB_BOOTSTATE_REASON_PRF_BUTTONS);
 			prf_requested = true;
 		}
+	} else {
+		pb_buttons_prf_cancel();
 	}
 
 	/* one last feed */
 	(void)pb_watchdog_feed();
 
 	if (prf_requested) {
+		/* not submitted if PRF was decided early, or running otherwise */
+		firmware_select_sync();
+
 		ret = pb_firmware_load_prf();
 		if (ret < 0) {
 			LOG_ERR("Failed to load PRF (err %d)", ret);
-			pb_panic(PB_PANIC_REASON_PRF_LOAD_FAIL(ret));
+			boot_panic(PB_PANIC_REASON_PRF_LOAD_FAIL(ret));
 		}
 	}
 
@@ -134,7 +253,7 @@ int main(void)
 	ret = pb_firmware_load();
 	if (ret < 0) {
 		LOG_ERR("Failed to load firmware (err %d)", ret);
-		pb_panic(PB_PANIC_REASON_FW_LOAD_FAIL(ret));
+		boot_panic(PB_PANIC_REASON_FW_LOAD_FAIL(ret));
 	}
 
 	return 0;
@@ -3,6 +3,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "bootlog.h"
+#include "bootstate.h"
 #include "buttons.h"
 #include "panic.h"
 #include "watchdog.h"
@@ -11,8 +13,12 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/logging/log_ctrl.h>
 #include <zephyr/sys/reboot.h>
+#include <zephyr/sys/util.h>
 #include <zephyr/toolchain.h>
 
+#include <pb/bootbit.h>
+#include <pb/drivers/console/pulse_uart_console.h>
+
 LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
 
 static bool initialized = false;
@@ -26,6 +32,8 @@ void k_sys_fatal_error_handler(unsigned int reason, const struct arch_esf *esf)
 
 	if (!initialized) {
 		LOG_PANIC();
+		pb_bootlog_commit();
+		pulse_uart_console_flush();
 		arch_system_halt(reason);
 	} else {
 		pb_panic(PB_PANIC_REASON_SYSTEM(reason));
@@ -40,15 +48,26 @@ void pb_panic_init(void)
 void FUNC_NORETURN pb_panic(pb_panic_reason_t reason)
 {
 	LOG_ERR("System panic (0x%08x), press any button to reset", reason);
+	pb_bootbit_commit();
+	pb_bootstate_panic(reason);
+	pb_bootstate_commit();
+	pb_bootlog_commit();
+	pulse_uart_console_flush();
 
 	while (1) {
 		if (pb_buttons_any_pressed()) {
 			LOG_INF("Resetting system due to button press");
+			pulse_uart_console_flush();
 			sys_reboot(SYS_REBOOT_COLD);
 		}
 
 		(void)pb_watchdog_feed();
 
-		k_msleep(10);
+		/* sleep when possible, this may be a low battery panic */
+		if (IS_ENABLED(CONFIG_MULTITHREADING) && !k_is_in_isr()) {
+			k_msleep(10);
+		} else {
+			k_busy_wait(10U * USEC_PER_MSEC);
+		}
 	}
 }
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "valcache.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/retention/retention.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#include <pb/bootbit.h>
+
+LOG_MODULE_DECLARE(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
+
+#define VALCACHE_VERSION 3U
+
+#define VALCACHE_ENTRY_VALID BIT(0)
+
+struct valcache_entry {
+	struct firmware_header hdr;
+	uint32_t hdr_crc;
+	uint32_t generation;
+	uint32_t flags;
+	uint32_t spot;
+	uint32_t hits;
+} __packed;
+
+struct valcache {
+	uint32_t version;
+	uint32_t generation;
+	struct valcache_entry entries[PB_VALCACHE_SLOTS];
+} __packed;
+
+static const struct device *retention = DEVICE_DT_GET(DT_CHOSEN(pb_valcache));
+static struct valcache cache;
+
+static void valcache_commit(void)
+{
+	int ret;
+
+	ret = retention_write(retention, 0U, (const uint8_t *)&cache, sizeof(cache));
+	if (ret < 0) {
+		LOG_ERR("Failed to write validation cache (err %d)", ret);
+	}
+}
+
+static void valcache_reset(void)
+{
+	memset(&cache, 0, sizeof(cache));
+	cache.version = VALCACHE_VERSION;
+
+	valcache_commit();
+}
+
+int pb_valcache_init(void)
+{
+	int ret;
+
+	if (!device_is_ready(retention)) {
+		LOG_ERR("Validation cache device not ready");
+		return -ENODEV;
+	}
+
+	if (retention_size(retention) < sizeof(cache)) {
+		LOG_ERR("Validation cache area too small");
+		return -ENOSPC;
+	}
+
+	if (pb_bootbit_tst(PB_BOOTBIT_NEW_FW_INSTALLED) ||
+	    pb_bootbit_tst(PB_BOOTBIT_NEW_FW_UPDATE_IN_PROGRESS)) {
+		LOG_INF("New firmware flagged, dropping validation cache");
+		valcache_reset();
+		return 0;
+	}
+
+	if (retention_is_valid(retention) != 1) {
+		valcache_reset();
+		return 0;
+	}
+
+	ret = retention_read(retention, 0U, (uint8_t *)&cache, sizeof(cache));
+	if ((ret < 0) || (cache.version != VALCACHE_VERSION)) {
+		valcache_reset();
+	}
+
+	return 0;
+}
+
+bool pb_valcache_lookup(uint8_t slot, const struct firmware_header *hdr, uint32_t hdr_crc)
+{
+	struct valcache_entry *entry;
+
+	__ASSERT_NO_MSG(slot < PB_VALCACHE_SLOTS);
+
+	entry = &cache.entries[slot];
+
+	if (((entry->flags & VALCACHE_ENTRY_VALID) == 0U) ||
+	    (entry->generation != cache.generation) || (entry->hdr_crc != hdr_crc) ||
+	    (memcmp(&entry->hdr, hdr, sizeof(*hdr)) != 0)) {
+		return false;
+	}
+
+	/* bound how long an image is trusted without being read in full */
+	if ((CONFIG_PB_VALIDATION_CACHE_MAX_HITS > 0) &&
+	    (entry->hits >= CONFIG_PB_VALIDATION_CACHE_MAX_HITS)) {
+		return false;
+	}
+
+	entry->hits++;
+
+	valcache_commit();
+
+	return true;
+}
+
+void pb_valcache_store(uint8_t slot, const struct firmware_header *hdr, uint32_t hdr_crc)
+{
+	struct valcache_entry *entry;
+
+	__ASSERT_NO_MSG(slot < PB_VALCACHE_SLOTS);
+
+	entry = &cache.entries[slot];
+
+	entry->hdr = *hdr;
+	entry->hdr_crc = hdr_crc;
+	entry->generation = cache.generation;
+	entry->flags = VALCACHE_ENTRY_VALID;
+	entry->spot = 0U;
+	entry->hits = 0U;
+
+	valcache_commit();
+}
+
+void pb_valcache_invalidate(uint8_t slot)
+{
+	struct valcache_entry *entry;
+
+	__ASSERT_NO_MSG(slot < PB_VALCACHE_SLOTS);
+
+	entry = &cache.entries[slot];
+	if (entry->flags == 0U) {
+		return;
+	}
+
+	memset(entry, 0, sizeof(*entry));
+
+	valcache_commit();
+}
+
+void pb_valcache_flash_written(void)
+{
+	/* entries stored before this point no longer match */
+	cache.generation++;
+
+	valcache_commit();
+}
+
+uint32_t pb_valcache_spot_next(uint8_t slot, uint32_t blocks, uint32_t count)
+{
+	struct valcache_entry *entry;
+	uint32_t first;
+
+	__ASSERT_NO_MSG(slot < PB_VALCACHE_SLOTS);
+
+	entry = &cache.entries[slot];
+
+	first = (entry->spot < count) ? entry->spot : 0U;
+	blocks = MIN(blocks, count - first);
+	entry->spot = ((first + blocks) < count) ? (first + blocks) : 0U;
+
+	valcache_commit();
+
+	return first;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file valcache.h
+ * @brief Validation cache for pblboot.
+ *
+ * The validation cache keeps the outcome of the last full validation of each
+ * slot in retained memory, so that an unchanged image does not need to be
+ * read in full again on the next warm reset. An entry is only trusted if the
+ * slot header matches the cached one byte by byte, the checksum of the whole
+ * header area (including the block digest table of v2 images) is unchanged,
+ * and no flash write has been done by the bootloader since the entry was
+ * stored (write generation). The whole cache is dropped if the retained
+ * memory is not valid (e.g. after a cold boot) or if the firmware signals that
+ * a new image is being or has been installed. An entry is also not trusted for
+ * more than @kconfig{CONFIG_PB_VALIDATION_CACHE_MAX_HITS} boots in a row.
+ */
+
+#ifndef BOOT_SRC_VALCACHE_H_
+#define BOOT_SRC_VALCACHE_H_
+
+#include "firmware.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Number of slots tracked by the validation cache */
+#define PB_VALCACHE_SLOTS 2U
+
+#ifdef CONFIG_PB_VALIDATION_CACHE
+
+/**
+ * @brief Initialize the validation cache
+ *
+ * The cache is invalidated if the retained memory contents are not valid or
+ * if any of the new firmware bootbits are set.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int pb_valcache_init(void);
+
+/**
+ * @brief Check if a slot is known to be valid.
+ *
+ * @param slot Slot index.
+ * @param hdr Slot header, as currently found in flash.
+ * @param hdr_crc Checksum of the slot header area, as currently found in flash.
+ *
+ * @retval true if the slot was fully validated before and is unchanged
+ * @retval false if the slot needs to be fully validated
+ */
+bool pb_valcache_lookup(uint8_t slot, const struct firmware_header *hdr, uint32_t hdr_crc);
+
+/**
+ * @brief Store a successful slot validation.
+ *
+ * @param slot Slot index.
+ * @param hdr Slot header.
+ * @param hdr_crc Checksum of the slot header area.
+ */
+void pb_valcache_store(uint8_t slot, const struct firmware_header *hdr, uint32_t hdr_crc);
+
+/**
+ * @brief Invalidate a slot entry.
+ *
+ * @param slot Slot index.
+ */
+void pb_valcache_invalidate(uint8_t slot);
+
+/**
+ * @brief Signal a flash write.
+ *
+ * Must be called before the bootloader erases or writes flash that may hold
+ * a firmware image. All entries stored before are no longer trusted.
+ */
+void pb_valcache_flash_written(void);
+
+/**
+ * @brief Get the next blocks to spot check.
+ *
+ * Each cached slot keeps a cursor, so that successive spot checks cover the
+ * whole image.
+ *
+ * @param slot Slot index.
+ * @param blocks Number of blocks to check.
+ * @param count Number of blocks in the image.
+ *
+ * @return First block to check.
+ */
+uint32_t pb_valcache_spot_next(uint8_t slot, uint32_t blocks, uint32_t count);
+
+#else
+
+static inline int pb_valcache_init(void)
+{
+	return 0;
+}
+
+static inline bool pb_valcache_lookup(uint8_t slot, const struct firmware_header *hdr,
+				      uint32_t hdr_crc)
+{
+	return false;
+}
+
+static inline void pb_valcache_store(uint8_t slot, const struct firmware_header *hdr,
+				     uint32_t hdr_crc)
+{
+}
+
+static inline void pb_valcache_invalidate(uint8_t slot)
+{
+}
+
+static inline void pb_valcache_flash_written(void)
+{
+}
+
+static inline uint32_t pb_valcache_spot_next(uint8_t slot, uint32_t blocks, uint32_t count)
+{
+	return 0U;
+}
+
+#endif /* CONFIG_PB_VALIDATION_CACHE */
+
+#endif /* BOOT_SRC_VALCACHE_H_ */
@@ -10,22 +10,36 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/uart.h>
 #include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
 #include <zephyr/net/net_ip.h>
-#include <zephyr/sys/crc.h>
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/libc-hooks.h>
 #include <zephyr/sys/printk-hooks.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/util.h>
 #include <zephyr/toolchain.h>
 
 #include <pb/cobs.h>
+#include <pb/crc.h>
+#include <pb/drivers/console/pulse_uart_console.h>
 
 #define MSG_BUF_LEN     256
 #define MSG_HDR_LEN     35
+#define MSG_CRC_LEN     4
 #define FRAME_DELIMITER 0x55U
 
+/* Pulse logging message types */
+#define MSG_TYPE_TEXT       1U
+#define MSG_TYPE_DICT       2U
+#define MSG_TYPE_TEXT_BATCH 3U
+
 static const struct device *const dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_console));
 
-static uint8_t msg_buf[MSG_BUF_LEN] = {
+/* message header, the length is filled in when the message is sent */
+static uint8_t msg_hdr[MSG_HDR_LEN] = {
 	/* Pulse transport push */
 	0x50U,
 	0x21U,
@@ -35,8 +49,8 @@ static uint8_t msg_buf[MSG_BUF_LEN] = {
 	/* Length (to be filled in) */
 	0,
 	0,
-	/* Message type: text */
-	1,
+	/* Message type: text (or batch of length prefixed text records) */
+	IS_ENABLED(CONFIG_PULSE_UART_CONSOLE_BATCH) ? MSG_TYPE_TEXT_BATCH : MSG_TYPE_TEXT,
 	/* Source filename */
 	'P',
 	'B',
@@ -71,51 +85,472 @@ static uint8_t msg_buf[MSG_BUF_LEN] = {
 	0,
 };
 
+/*
+ * Message being built: the payload goes through the CRC and the COBS encoder as
+ * it arrives, only the header, its length and the CRC are left for the end.
+ */
 static size_t msg_len = MSG_HDR_LEN;
+static uint32_t msg_crc;
+static struct pb_cobs_enc msg_enc;
 
-static int console_out(int c)
+/* COBS blocks completed before the message is sent, which starts with the header */
+static uint8_t msg_blocks[PB_COBS_MAX_ENC_SIZE(MSG_BUF_LEN - MSG_HDR_LEN)];
+static size_t msg_blocks_len;
+static bool msg_sending;
+
+#ifdef CONFIG_MULTITHREADING
+/* serializes writers from different threads (e.g. boot tasks) */
+static K_MUTEX_DEFINE(console_mutex);
+
+/* interrupts (e.g. fatal errors) and early output are not serialized */
+static inline bool console_lockable(void)
+{
+	return !k_is_in_isr() && !k_is_pre_kernel();
+}
+
+static inline void console_lock(void)
+{
+	if (console_lockable()) {
+		(void)k_mutex_lock(&console_mutex, K_FOREVER);
+	}
+}
+
+static inline void console_unlock(void)
+{
+	if (console_lockable()) {
+		(void)k_mutex_unlock(&console_mutex);
+	}
+}
+#else
+static inline void console_lock(void)
+{
+}
+
+static inline void console_unlock(void)
+{
+}
+#endif /* CONFIG_MULTITHREADING */
+
+#ifdef CONFIG_PULSE_UART_CONSOLE_ASYNC
+RING_BUF_DECLARE(tx_rb, CONFIG_PULSE_UART_CONSOLE_TX_BUF_SIZE);
+
+/* true if output must bypass the TX buffer (e.g. interrupts locked) */
+static bool tx_sync;
+
+static void console_isr(const struct device *uart, void *user_data)
 {
+	ARG_UNUSED(user_data);
+
+	while ((uart_irq_update(uart) > 0) && (uart_irq_is_pending(uart) > 0)) {
+		uint8_t *data;
+		uint32_t len;
+		int sent;
+
+		if (uart_irq_tx_ready(uart) <= 0) {
+			break;
+		}
+
+		len = ring_buf_get_claim(&tx_rb, &data, CONFIG_PULSE_UART_CONSOLE_TX_BUF_SIZE);
+		if (len == 0U) {
+			uart_irq_tx_disable(uart);
+			break;
+		}
+
+		sent = uart_fifo_fill(uart, data, (int)len);
+		(void)ring_buf_get_finish(&tx_rb, MAX(sent, 0));
+	}
+}
+
+/* send all buffered data synchronously */
+static void console_tx_drain(void)
+{
+	unsigned int key;
+	uint8_t b;
+
+	key = irq_lock();
+
+	uart_irq_tx_disable(dev);
+	while (ring_buf_get(&tx_rb, &b, 1U) == 1U) {
+		uart_poll_out(dev, b);
+	}
+
+	irq_unlock(key);
+}
+
+static void console_tx_begin(void)
+{
+	unsigned int key;
+
+	key = irq_lock();
+	tx_sync = k_is_in_isr() || !arch_irq_unlocked(key);
+	irq_unlock(key);
+
+	/* keep output ordered when falling back to synchronous output */
+	if (tx_sync) {
+		console_tx_drain();
+	}
+}
+
+static void console_tx_put(uint8_t b)
+{
+	unsigned int key;
+	uint32_t put;
+
+	if (tx_sync) {
+		uart_poll_out(dev, b);
+		return;
+	}
+
+	do {
+		key = irq_lock();
+		put = ring_buf_put(&tx_rb, &b, 1U);
+		irq_unlock(key);
+
+		if (put == 0U) {
+			/* buffer full, make room by sending it synchronously */
+			console_tx_drain();
+		}
+	} while (put == 0U);
+}
+
+static void console_tx_end(void)
+{
+	if (!tx_sync) {
+		uart_irq_tx_enable(dev);
+	}
+}
+
+static void console_tx_flush(void)
+{
+	uint32_t waited_us = 0U;
+
+	/* give the interrupt driven path a chance to finish */
+	while (!ring_buf_is_empty(&tx_rb) &&
+	       (waited_us < CONFIG_PULSE_UART_CONSOLE_FLUSH_TIMEOUT_US)) {
+		k_busy_wait(10U);
+		waited_us += 10U;
+	}
+
+	console_tx_drain();
+}
+#else
+static inline void console_tx_begin(void)
+{
+}
+
+static inline void console_tx_put(uint8_t b)
+{
+	uart_poll_out(dev, b);
+}
+
+static inline void console_tx_end(void)
+{
+}
+
+static inline void console_tx_flush(void)
+{
+}
+#endif /* CONFIG_PULSE_UART_CONSOLE_ASYNC */
+
+/* COBS encoder output: frame delimiter is swapped with zero (not present after COBS) */
+static void console_frame_out(const uint8_t *data, size_t len, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	for (size_t i = 0U; i < len; i++) {
+		console_tx_put((data[i] == FRAME_DELIMITER) ? 0U : data[i]);
+	}
+}
+
+static void console_msg_blocks_out(const uint8_t *data, size_t len, void *user_data)
+{
+	if (msg_sending) {
+		console_frame_out(data, len, user_data);
+		return;
+	}
+
+	memcpy(&msg_blocks[msg_blocks_len], data, len);
+	msg_blocks_len += len;
+}
+
+static void console_msg_reset(void)
+{
+	msg_len = MSG_HDR_LEN;
+	msg_crc = 0U;
+	msg_blocks_len = 0U;
+	msg_sending = false;
+
+	pb_cobs_enc_init(&msg_enc, console_msg_blocks_out, NULL);
+}
+
+/* add data to the message payload */
+static void console_msg_put(const uint8_t *data, size_t len)
+{
+	msg_crc = pb_crc32_ieee_update(msg_crc, data, len);
+	pb_cobs_enc_update(&msg_enc, data, len);
+	msg_len += len;
+}
+
+static void console_msg_send(void)
+{
+	uint8_t hdr[PB_COBS_MAX_ENC_SIZE(MSG_HDR_LEN)];
+	uint8_t crc[MSG_CRC_LEN];
+	size_t hdr_len;
+
+	/* fill message length (not counting pulse transport push code)*/
+	sys_put_be16(msg_len - 2U, &msg_hdr[4]);
+
+	sys_put_le32(pb_crc32_ieee_combine(pb_crc32_ieee(msg_hdr, sizeof(msg_hdr)), msg_crc,
+					   msg_len - MSG_HDR_LEN),
+		     crc);
+
+	/*
+	 * The header ends with a zero (line number), so its COBS blocks do not
+	 * depend on the payload: the payload blocks follow them, in place of the
+	 * empty block ending the header encoding.
+	 */
+	hdr_len = pb_cobs_encode(hdr, msg_hdr, sizeof(msg_hdr)) - 1U;
+
+	console_tx_begin();
+	console_tx_put(FRAME_DELIMITER);
+
+	console_frame_out(hdr, hdr_len, NULL);
+	console_frame_out(msg_blocks, msg_blocks_len, NULL);
+
+	msg_sending = true;
+	pb_cobs_enc_update(&msg_enc, crc, sizeof(crc));
+	pb_cobs_enc_finish(&msg_enc);
+
+	console_tx_put(FRAME_DELIMITER);
+	console_tx_end();
+
+	console_msg_reset();
+}
+
+#ifdef CONFIG_PULSE_UART_CONSOLE_BATCH
+/* longest record, a record and its length prefix must fit in a message */
+#define REC_MAX_LEN (MSG_BUF_LEN - MSG_HDR_LEN - 1)
+
+/* current record, added to the message once complete (it starts with its length) */
+static uint8_t rec_buf[REC_MAX_LEN];
+static size_t rec_len;
+static bool rec_open;
+
+/* send all complete records, keeping the current (incomplete) one if any */
+static void console_batch_send(void)
+{
+	if (msg_len > MSG_HDR_LEN) {
+		console_msg_send();
+	}
+}
+
+/* complete the current record, if any */
+static void console_rec_close(void)
+{
+	uint8_t len = (uint8_t)rec_len;
+
+	if (rec_open) {
+		console_msg_put(&len, 1U);
+		console_msg_put(rec_buf, rec_len);
+
+		rec_len = 0U;
+		rec_open = false;
+	}
+}
+
+static void console_put(int c)
+{
+	uint8_t b = (uint8_t)c;
+
 	if (c == '\n') {
-		uint32_t crc;
-		uint8_t msg_enc[PB_COBS_MAX_ENC_SIZE(msg_len + sizeof(crc))];
-		size_t msg_enc_len;
-
-		/* fill message length (not counting pulse transport push code)*/
-		sys_put_be16(msg_len - 2U, &msg_buf[4]);
-
-		/* append CRC32 */
-		crc = crc32_ieee(msg_buf, msg_len);
-		sys_put_le32(crc, &msg_buf[msg_len]);
-
-		/* COBS encode */
-		msg_enc_len = pb_cobs_encode(msg_enc, msg_buf, msg_len + sizeof(crc));
-
-		/* send frame */
-		uart_poll_out(dev, FRAME_DELIMITER);
-		for (size_t i = 0U; i < msg_enc_len; i++) {
-			if (msg_enc[i] == FRAME_DELIMITER) {
-				uart_poll_out(dev, '\0');
-			} else {
-				uart_poll_out(dev, msg_enc[i]);
+		if (rec_open) {
+			console_rec_close();
+		} else {
+			/* empty line, a zero length record */
+			if ((msg_len + 1U) > MSG_BUF_LEN) {
+				console_batch_send();
 			}
+
+			b = 0U;
+			console_msg_put(&b, 1U);
+		}
+
+		if (msg_len >= CONFIG_PULSE_UART_CONSOLE_BATCH_THRESHOLD) {
+			console_batch_send();
+		}
+	} else if (c != '\r') {
+		/* make room by sending complete records */
+		if ((msg_len + rec_len + 2U) > MSG_BUF_LEN) {
+			console_batch_send();
 		}
-		uart_poll_out(dev, FRAME_DELIMITER);
 
-		/* reset message length counter */
-		msg_len = MSG_HDR_LEN;
-	} else if (c != '\r' && msg_len < MSG_BUF_LEN) {
-		msg_buf[msg_len++] = (uint8_t)c;
+		rec_open = true;
+
+		/* records longer than the buffer are truncated */
+		if ((msg_len + rec_len + 1U) < MSG_BUF_LEN) {
+			rec_buf[rec_len++] = b;
+		}
+	}
+}
+#else
+static void console_put(int c)
+{
+	uint8_t b = (uint8_t)c;
+
+	if (c == '\n') {
+		console_msg_send();
+	} else if ((c != '\r') && (msg_len < MSG_BUF_LEN)) {
+		console_msg_put(&b, 1U);
 	}
+}
+#endif /* CONFIG_PULSE_UART_CONSOLE_BATCH */
+
+static int console_out(int c)
+{
+	console_lock();
+	console_put(c);
+	console_unlock();
 
 	return c;
 }
 
+void pulse_uart_console_flush(void)
+{
+	console_lock();
+
+	/* a line may be left without its newline, e.g. on panic: send it as is */
+#ifdef CONFIG_PULSE_UART_CONSOLE_BATCH
+	console_rec_close();
+	console_batch_send();
+#else
+	if (msg_len > MSG_HDR_LEN) {
+		console_msg_send();
+	}
+#endif
+
+	console_tx_flush();
+
+	console_unlock();
+}
+
+#ifdef CONFIG_PULSE_UART_CONSOLE_LOG_DICT
+#define DICT_HDR_LEN 7
+
+/* dictionary message, with room for the trailing CRC */
+static uint8_t dict_buf[MSG_BUF_LEN + MSG_CRC_LEN] = {
+	/* Pulse transport push */
+	0x50U,
+	0x21U,
+	/* Pulse protocol logging */
+	0x00U,
+	0x03U,
+	/* Length (to be filled in) */
+	0,
+	0,
+	/* Message type: dictionary */
+	MSG_TYPE_DICT,
+};
+
+static size_t dict_len = DICT_HDR_LEN;
+
+/*
+ * Send buf[0:len] as a frame. buf must have room for the CRC after the
+ * message. COBS blocks are sent as soon as they are encoded, so no encoded
+ * copy of the frame is needed.
+ */
+static void console_frame_send(uint8_t *buf, size_t len)
+{
+	static struct pb_cobs_enc enc;
+
+	sys_put_le32(pb_crc32_ieee(buf, len), &buf[len]);
+
+	console_tx_begin();
+	console_tx_put(FRAME_DELIMITER);
+
+	pb_cobs_enc_init(&enc, console_frame_out, NULL);
+	pb_cobs_enc_update(&enc, buf, len + MSG_CRC_LEN);
+	pb_cobs_enc_finish(&enc);
+
+	console_tx_put(FRAME_DELIMITER);
+	console_tx_end();
+}
+static uint8_t dict_out_buf[CONFIG_PULSE_UART_CONSOLE_LOG_DICT_BUF_SIZE];
+
+static int dict_out(uint8_t *data, size_t length, void *ctx)
+{
+	size_t len = MIN(length, MSG_BUF_LEN - dict_len);
+
+	ARG_UNUSED(ctx);
+
+	/* truncate messages not fitting in a frame, the decoder will flag them */
+	memcpy(&dict_buf[dict_len], data, len);
+	dict_len += len;
+
+	return (int)length;
+}
+
+LOG_OUTPUT_DEFINE(dict_output, dict_out, dict_out_buf, sizeof(dict_out_buf));
+
+static void dict_send(void)
+{
+	/* fill message length (not counting pulse transport push code)*/
+	sys_put_be16(dict_len - 2U, &dict_buf[4]);
+
+	console_frame_send(dict_buf, dict_len);
+
+	dict_len = DICT_HDR_LEN;
+}
+
+static void dict_process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+
+	console_lock();
+	log_dict_output_msg_process(&dict_output, &msg->log, 0U);
+	dict_send();
+	console_unlock();
+}
+
+static void dict_dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	console_lock();
+	log_dict_output_dropped_process(&dict_output, cnt);
+	dict_send();
+	console_unlock();
+}
+
+static void dict_panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+
+	/* nothing to do, output falls back to polling with interrupts locked */
+}
+
+static const struct log_backend_api dict_api = {
+	.process = dict_process,
+	.dropped = dict_dropped,
+	.panic = dict_panic,
+};
+
+LOG_BACKEND_DEFINE(pulse_uart_console_dict, dict_api, true);
+#endif /* CONFIG_PULSE_UART_CONSOLE_LOG_DICT */
+
 static int pulse_uart_console_init(void)
 {
 	if (!device_is_ready(dev)) {
 		return -ENODEV;
 	}
 
+#ifdef CONFIG_PULSE_UART_CONSOLE_ASYNC
+	if (uart_irq_callback_user_data_set(dev, console_isr, NULL) < 0) {
+		return -ENOTSUP;
+	}
+#endif
+
+	console_msg_reset();
+
 #ifdef CONFIG_STDOUT_CONSOLE
 	__stdout_hook_install(console_out);
 #endif
@@ -54,13 +54,27 @@ enum pb_bootbit {
 	PB_BOOTBIT_FORCE_PRF = 17,
 	/** New PRF is available for installation */
 	PB_BOOTBIT_NEW_PRF_AVAILABLE = 18,
+	/** Send bootloader logs to the UART, not only to the boot log */
+	PB_BOOTBIT_BOOTLOG_UART = 20,
 };
 
 /**
  * @brief Initialize the boot bits system.
+ *
+ * Boot bits are loaded from storage into a RAM shadow. All other operations
+ * work on the shadow, changes are only written back to storage by
+ * pb_bootbit_commit(), in a single store.
  */
 void pb_bootbit_init(void);
 
+/**
+ * @brief Commit boot bits to storage.
+ *
+ * This must be called after updating boot state, and before jumping to the
+ * firmware or resetting. Nothing is written if boot bits are unchanged.
+ */
+void pb_bootbit_commit(void);
+
 /**
  * @brief Set the specified boot bit.
  *
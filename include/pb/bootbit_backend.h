@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file bootbit_backend.h
+ * @brief Boot bit storage backend interface.
+ *
+ * Boot bits are operated on a RAM shadow, a backend only needs to load and
+ * store the whole 32-bit word, each in a single access. With
+ * @kconfig{CONFIG_PB_BOOTBIT_APP_STATE}, the shadow is kept by the application
+ * and the backend is used directly.
+ */
+
+#ifndef PB_BOOTBIT_BACKEND_H
+#define PB_BOOTBIT_BACKEND_H
+
+#include <stdint.h>
+
+/**
+ * @brief Load boot bits from storage.
+ *
+ * @return Boot bits word.
+ */
+uint32_t pb_bootbit_backend_load(void);
+
+/**
+ * @brief Store boot bits to storage.
+ *
+ * @param bits Boot bits word.
+ */
+void pb_bootbit_backend_store(uint32_t bits);
+
+#endif /* PB_BOOTBIT_BACKEND_H */
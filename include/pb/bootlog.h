@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file bootlog.h
+ * @brief Boot log (bootloader to firmware ABI).
+ *
+ * The bootloader stores its log output in a retained RAM area at a fixed
+ * address (pb,bootlog chosen node). The area follows the Zephyr retention
+ * layout: a 4-byte "PBBL" prefix, the boot log, and a CRC32-IEEE of the
+ * prefix and the boot log. The firmware is expected to check the prefix, the
+ * checksum and the boot log version before using it.
+ *
+ * The boot log is a header followed by a ring buffer of text. Log lines are
+ * stored as printed, terminated by a newline. If more than
+ * @ref pb_bootlog_header.size bytes were printed, only the last
+ * @ref pb_bootlog_header.size bytes are kept, starting at offset
+ * @ref pb_bootlog_header.head modulo @ref pb_bootlog_header.size.
+ */
+
+#ifndef PB_BOOTLOG_H
+#define PB_BOOTLOG_H
+
+#include <stdint.h>
+
+/** Boot log version */
+#define PB_BOOTLOG_VERSION 1U
+
+/** Boot log header */
+struct pb_bootlog_header {
+	/** Boot log version (@ref PB_BOOTLOG_VERSION) */
+	uint32_t version;
+	/** Ring buffer size, in bytes */
+	uint32_t size;
+	/** Total number of bytes printed during boot */
+	uint32_t head;
+};
+
+#endif /* PB_BOOTLOG_H */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file bootstate.h
+ * @brief Boot state block (bootloader to firmware ABI).
+ *
+ * The bootloader keeps a boot state block in a retained RAM area at a fixed
+ * address (pb,bootstate chosen node). The area follows the Zephyr retention
+ * layout: a 4-byte "PBBS" prefix, the block, and a CRC32-IEEE of the prefix and
+ * the block. The firmware is expected to check the prefix, the checksum and the
+ * block version before using it.
+ *
+ * The block holds the boot bits as last committed by the bootloader (the boot
+ * bits storage, e.g. RTC backup register, is written from it and stays the
+ * interface to update them), cumulative statistics since the retained RAM was
+ * last lost (e.g. cold boot), wide consecutive failure and reset counters
+ * updated on the same decisions as the boot bits counters, and a ring of the last
+ * @ref PB_BOOTSTATE_HISTORY_LEN boot records. Records are written right before
+ * jumping to an image, or on panic.
+ */
+
+#ifndef PB_BOOTSTATE_H
+#define PB_BOOTSTATE_H
+
+#include <stdint.h>
+
+/** Boot state block version */
+#define PB_BOOTSTATE_VERSION 3U
+
+/** Number of boot records kept */
+#define PB_BOOTSTATE_HISTORY_LEN 8U
+
+/** Booted image */
+enum pb_bootstate_slot {
+	/** slot0 firmware */
+	PB_BOOTSTATE_SLOT_0 = 0,
+	/** slot1 firmware */
+	PB_BOOTSTATE_SLOT_1 = 1,
+	/** PRF */
+	PB_BOOTSTATE_SLOT_PRF = 2,
+	/** No image booted (e.g. panic) */
+	PB_BOOTSTATE_SLOT_NONE = 0xFF,
+};
+
+/** Boot reason, as decided by the bootloader state machine */
+enum pb_bootstate_reason {
+	/** Normal boot */
+	PB_BOOTSTATE_REASON_NORMAL = 0,
+	/** Last firmware boot was stable, failure counters cleared */
+	PB_BOOTSTATE_REASON_STABLE = 1,
+	/** Firmware failure caused a reset, firmware retried */
+	PB_BOOTSTATE_REASON_FW_FAIL = 2,
+	/** Firmware failed too many times, PRF requested */
+	PB_BOOTSTATE_REASON_FW_STRIKES = 3,
+	/** PRF failure caused a reset, PRF retried */
+	PB_BOOTSTATE_REASON_PRF_FAIL = 4,
+	/** PRF failed too many times */
+	PB_BOOTSTATE_REASON_PRF_STRIKES = 5,
+	/** PRF requested by the firmware */
+	PB_BOOTSTATE_REASON_PRF_FORCED = 6,
+	/** PRF requested with buttons */
+	PB_BOOTSTATE_REASON_PRF_BUTTONS = 7,
+	/** No valid firmware found, PRF loaded */
+	PB_BOOTSTATE_REASON_NO_FW = 8,
+	/** Reset loop detected */
+	PB_BOOTSTATE_REASON_RESET_LOOP = 9,
+};
+
+/** Boot record */
+struct pb_bootstate_record {
+	/** Boot sequence number (@ref pb_bootstate.boots at that boot) */
+	uint32_t seq;
+	/** Time spent validating images (us) */
+	uint32_t validation_us;
+	/** Panic reason, 0 if none */
+	uint32_t panic;
+	/** Booted image (@ref pb_bootstate_slot) */
+	uint8_t slot;
+	/** Boot reason (@ref pb_bootstate_reason) */
+	uint8_t reason;
+	/** Consecutive resets when that boot started (@ref pb_bootstate.reset_cnt) */
+	uint16_t reset_cnt;
+};
+
+/** Boot state block */
+struct pb_bootstate {
+	/** Block version (@ref PB_BOOTSTATE_VERSION) */
+	uint32_t version;
+	/** Total number of boots */
+	uint32_t boots;
+	/** Total number of firmware failures */
+	uint32_t fw_fails;
+	/** Total number of PRF failures */
+	uint32_t prf_fails;
+	/** Total number of PRF boots */
+	uint32_t prf_boots;
+	/** Total number of panics */
+	uint32_t panics;
+	/** Total number of reset loops detected */
+	uint32_t reset_loops;
+	/** Boot bits word (see pb/bootbit.h), as last committed by the bootloader */
+	uint32_t bootbits;
+	/** Index of the next record to be written in @ref pb_bootstate.history */
+	uint16_t history_head;
+	/** Consecutive resets (not limited to the boot bits counter range) */
+	uint16_t reset_cnt;
+	/** Consecutive firmware failures (not limited to the boot bits strikes range) */
+	uint16_t fw_fail_cnt;
+	/** Consecutive PRF failures (not limited to the boot bits strikes range) */
+	uint16_t prf_fail_cnt;
+	/** Last boot records, oldest at @ref pb_bootstate.history_head once full */
+	struct pb_bootstate_record history[PB_BOOTSTATE_HISTORY_LEN];
+};
+
+#endif /* PB_BOOTSTATE_H */
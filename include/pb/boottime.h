@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file boottime.h
+ * @brief Boot timing record (bootloader to firmware ABI).
+ *
+ * The bootloader stores a boot timing record in a retained RAM area at a
+ * fixed address (pb,boottime chosen node). The area follows the Zephyr
+ * retention layout: a 4-byte "PBBT" prefix, the record, and a CRC32-IEEE of
+ * the prefix and the record. The firmware is expected to check the prefix,
+ * the checksum and the record version before using it.
+ *
+ * All timestamps are counter values taken from the same free running
+ * counter, running at @ref pb_boottime_record.freq Hz. A value of 0 means the
+ * corresponding point was not reached. The teardown done right before jumping
+ * to the firmware is not included, it can be measured by the firmware by
+ * reading the same counter at startup and comparing it with
+ * @ref PB_BOOTTIME_MARK_JUMP.
+ */
+
+#ifndef PB_BOOTTIME_H
+#define PB_BOOTTIME_H
+
+#include <stdint.h>
+
+/** Boot timing record version */
+#define PB_BOOTTIME_VERSION 1U
+
+/** Boot timing marks, taken at the end of each boot phase */
+enum pb_boottime_mark {
+	/** Bootloader main() entry */
+	PB_BOOTTIME_MARK_MAIN = 0,
+	/** Bootbits initialized */
+	PB_BOOTTIME_MARK_BOOTBIT_INIT = 1,
+	/** Buttons, watchdog, charger and firmware modules initialized */
+	PB_BOOTTIME_MARK_PERIPH_INIT = 2,
+	/** Charger sensor fetched and boot allowed */
+	PB_BOOTTIME_MARK_CHARGER = 3,
+	/** Bootbit state machine and PRF requests handled */
+	PB_BOOTTIME_MARK_BOOT_STATE = 4,
+	/** Right before tearing down the bootloader and jumping */
+	PB_BOOTTIME_MARK_JUMP = 5,
+	/** Number of marks */
+	PB_BOOTTIME_MARK_COUNT = 6,
+};
+
+/** Image validations */
+enum pb_boottime_validation {
+	/** slot0 validation */
+	PB_BOOTTIME_VALIDATION_SLOT0 = 0,
+	/** slot1 validation */
+	PB_BOOTTIME_VALIDATION_SLOT1 = 1,
+	/** PRF validation */
+	PB_BOOTTIME_VALIDATION_PRF = 2,
+	/** Number of validations */
+	PB_BOOTTIME_VALIDATION_COUNT = 3,
+};
+
+/** Boot timing record */
+struct pb_boottime_record {
+	/** Record version (@ref PB_BOOTTIME_VERSION) */
+	uint32_t version;
+	/** Counter frequency (Hz) */
+	uint32_t freq;
+	/** Counter value at each mark (@ref pb_boottime_mark) */
+	uint32_t marks[PB_BOOTTIME_MARK_COUNT];
+	/** Duration of each validation in counter ticks (@ref pb_boottime_validation) */
+	uint32_t validations[PB_BOOTTIME_VALIDATION_COUNT];
+};
+
+#endif /* PB_BOOTTIME_H */
@@ -6,7 +6,9 @@
 #ifndef PB_COBS_H
 #define PB_COBS_H
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /** Evaluates to the offset required when encoding in-place. */
 #define PB_COBS_OVERHEAD(n) (((n) + 253) / 254)
@@ -17,7 +19,11 @@
 /**
  * @brief COBS encode data.
  *
- * @param[out] dst Destination buffer
+ * Zero-free runs are located a word at a time and copied as a whole. A block
+ * is terminated after 254 non-zero bytes, as required by COBS.
+ *
+ * @param[out] dst Destination buffer, at least PB_COBS_MAX_ENC_SIZE(len)
+ *                 bytes (1 byte if @p len is 0).
  * @param[in] src Source buffer
  * @param len Length of source data
  *
@@ -25,4 +31,89 @@
  */
 size_t pb_cobs_encode(void *dst, const void *src, size_t len);
 
+/**
+ * @brief COBS encode data in-place.
+ *
+ * Data to be encoded must be placed at offset PB_COBS_OVERHEAD(len) of
+ * @p buf, and @p buf must be at least PB_COBS_MAX_ENC_SIZE(len) bytes (1 byte
+ * if @p len is 0). Encoded data is written at the start of @p buf.
+ *
+ * @param[in,out] buf Buffer
+ * @param len Length of data
+ *
+ * @return Length of encoded data
+ */
+size_t pb_cobs_encode_inplace(void *buf, size_t len);
+
+/**
+ * @brief COBS encoder output callback.
+ *
+ * @param[in] data Encoded data
+ * @param len Length of encoded data
+ * @param user_data User data
+ */
+typedef void (*pb_cobs_out_t)(const uint8_t *data, size_t len, void *user_data);
+
+/**
+ * @brief Streaming COBS encoder.
+ *
+ * Data can be provided in pieces of any size, the output is the same as
+ * pb_cobs_encode() over the concatenation of all pieces. Encoded data is
+ * passed to the output callback a block at a time, so at most 255 bytes are
+ * buffered.
+ */
+struct pb_cobs_enc {
+	/** Output callback */
+	pb_cobs_out_t out;
+	/** User data passed to the output callback */
+	void *user_data;
+	/* internal state */
+	uint8_t block[255];
+	uint8_t len;
+	bool pending;
+};
+
+/**
+ * @brief Initialize a streaming COBS encoder.
+ *
+ * @param enc Encoder
+ * @param out Output callback
+ * @param user_data User data passed to @p out
+ */
+void pb_cobs_enc_init(struct pb_cobs_enc *enc, pb_cobs_out_t out, void *user_data);
+
+/**
+ * @brief Encode data with a streaming COBS encoder.
+ *
+ * @param enc Encoder
+ * @param[in] data Data
+ * @param len Length of data
+ */
+void pb_cobs_enc_update(struct pb_cobs_enc *enc, const void *data, size_t len);
+
+/**
+ * @brief Finish encoding with a streaming COBS encoder.
+ *
+ * The last block is output. The encoder must be initialized again before
+ * being reused.
+ *
+ * @param enc Encoder
+ */
+void pb_cobs_enc_finish(struct pb_cobs_enc *enc);
+
+/**
+ * @brief COBS decode data.
+ *
+ * Decoded data is never larger than encoded data, so @p dst needs at most
+ * @p len bytes. @p dst may be the same as @p src to decode in-place.
+ *
+ * @param[out] dst Destination buffer
+ * @param[in] src Source buffer, without frame delimiters
+ * @param len Length of source data
+ *
+ * @return Length of decoded data
+ * @retval -EINVAL if source data is not valid COBS
+ */
+int pb_cobs_decode(void *dst, const void *src, size_t len);
+
 #endif /* PB_COBS_H */
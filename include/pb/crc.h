@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PB_CRC_H
+#define PB_CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Update a CRC32-IEEE checksum.
+ *
+ * Results are bit-identical to Zephyr's crc32_ieee_update().
+ *
+ * @param crc Previous CRC value (0 for the first call).
+ * @param data Data.
+ * @param len Length of data.
+ *
+ * @return Updated CRC value.
+ */
+uint32_t pb_crc32_ieee_update(uint32_t crc, const void *data, size_t len);
+
+/**
+ * @brief Compute a CRC32-IEEE checksum.
+ *
+ * @param data Data.
+ * @param len Length of data.
+ *
+ * @return CRC value.
+ */
+static inline uint32_t pb_crc32_ieee(const void *data, size_t len)
+{
+	return pb_crc32_ieee_update(0U, data, len);
+}
+
+/**
+ * @brief Generate the operator combining CRC32-IEEE checksums.
+ *
+ * @param len2 Length of the second data block.
+ *
+ * @return Operator for pb_crc32_ieee_combine_op().
+ */
+uint32_t pb_crc32_ieee_combine_gen(size_t len2);
+
+/**
+ * @brief Combine two CRC32-IEEE checksums using a precomputed operator.
+ *
+ * @param crc1 CRC of the first data block.
+ * @param crc2 CRC of the second data block.
+ * @param op Operator, from pb_crc32_ieee_combine_gen() for the length of the
+ *           second data block.
+ *
+ * @return CRC of both data blocks, concatenated.
+ */
+uint32_t pb_crc32_ieee_combine_op(uint32_t crc1, uint32_t crc2, uint32_t op);
+
+/**
+ * @brief Combine two CRC32-IEEE checksums.
+ *
+ * This allows the checksum of some data to be obtained from the checksums of
+ * its parts, without reading the data again.
+ *
+ * @param crc1 CRC of the first data block.
+ * @param crc2 CRC of the second data block.
+ * @param len2 Length of the second data block.
+ *
+ * @return CRC of both data blocks, concatenated.
+ */
+static inline uint32_t pb_crc32_ieee_combine(uint32_t crc1, uint32_t crc2, size_t len2)
+{
+	return pb_crc32_ieee_combine_op(crc1, crc2, pb_crc32_ieee_combine_gen(len2));
+}
+
+#endif /* PB_CRC_H */
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PB_DRIVERS_CONSOLE_PULSE_UART_CONSOLE_H
+#define PB_DRIVERS_CONSOLE_PULSE_UART_CONSOLE_H
+
+#if defined(CONFIG_PULSE_UART_CONSOLE) && (defined(CONFIG_PRINTK) || defined(CONFIG_STDOUT_CONSOLE))
+
+/**
+ * @brief Flush pending console output.
+ *
+ * Sends any pending batch of lines, and the current line even if it is not
+ * complete (e.g. on panic). With interrupt driven transmission, then waits up
+ * to @kconfig{CONFIG_PULSE_UART_CONSOLE_FLUSH_TIMEOUT_US} for buffered output
+ * to be sent, and sends whatever is left synchronously.
+ */
+void pulse_uart_console_flush(void);
+
+#else
+
+static inline void pulse_uart_console_flush(void)
+{
+}
+
+#endif /* CONFIG_PULSE_UART_CONSOLE && (CONFIG_PRINTK || CONFIG_STDOUT_CONSOLE) */
+
+#endif /* PB_DRIVERS_CONSOLE_PULSE_UART_CONSOLE_H */
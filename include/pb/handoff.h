@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file handoff.h
+ * @brief Handoff record (bootloader to firmware ABI).
+ *
+ * Right before jumping to an image, the bootloader stores a handoff record in
+ * a retained RAM area at a fixed address (pb,handoff chosen node), describing
+ * what it already did: the booted image, whether its integrity was verified,
+ * the state of the other slot, the battery voltage and the reset cause. The
+ * firmware can use it to skip redundant checks at startup.
+ *
+ * The area follows the Zephyr retention layout: a 4-byte "PBHO" prefix, the
+ * record, and a CRC32-IEEE of the prefix and the record. The firmware is
+ * expected to check the prefix, the checksum and the record version before
+ * using it, and to invalidate the area (e.g. clear the prefix) once consumed,
+ * so that a stale record is never used.
+ *
+ * The handoff area is part of a retained RAM region shared with the other
+ * bootloader records (on pt2, 4 KiB at 0x2007f000, see the README). The
+ * firmware must reserve the whole region: it must not place data there nor
+ * clear it at startup.
+ */
+
+#ifndef PB_HANDOFF_H
+#define PB_HANDOFF_H
+
+#include <stdint.h>
+
+/** Handoff record version */
+#define PB_HANDOFF_VERSION 1U
+
+/**
+ * @name PB_HANDOFF_FLAG Handoff record flags
+ * @{
+ */
+
+/** Image CRC has been verified against its header on this boot */
+#define PB_HANDOFF_FLAG_VERIFIED          (1UL << 0)
+/**
+ * Image was not re-verified on this boot: it was trusted from the validation
+ * cache, and @ref PB_HANDOFF_FLAG_VERIFIED is not set. The image body may have
+ * changed since it was last verified.
+ */
+#define PB_HANDOFF_FLAG_CACHED            (1UL << 1)
+/** @ref pb_handoff.vbat_mv is valid */
+#define PB_HANDOFF_FLAG_VBAT_VALID        (1UL << 2)
+/** @ref pb_handoff.reset_cause is valid */
+#define PB_HANDOFF_FLAG_RESET_CAUSE_VALID (1UL << 3)
+
+/** @} */
+
+/** Booted image */
+enum pb_handoff_slot {
+	/** slot0 firmware */
+	PB_HANDOFF_SLOT_0 = 0,
+	/** slot1 firmware */
+	PB_HANDOFF_SLOT_1 = 1,
+	/** PRF */
+	PB_HANDOFF_SLOT_PRF = 2,
+};
+
+/** State of the firmware slot not booted */
+enum pb_handoff_backup {
+	/** Not applicable (e.g. PRF booted) */
+	PB_HANDOFF_BACKUP_UNKNOWN = 0,
+	/** No valid header */
+	PB_HANDOFF_BACKUP_EMPTY = 1,
+	/** Valid header, image not checked */
+	PB_HANDOFF_BACKUP_UNCHECKED = 2,
+	/** Image checked and corrupted */
+	PB_HANDOFF_BACKUP_INVALID = 3,
+};
+
+/** Handoff record */
+struct pb_handoff {
+	/** Record version (@ref PB_HANDOFF_VERSION) */
+	uint32_t version;
+	/** Flags (see @ref PB_HANDOFF_FLAG) */
+	uint32_t flags;
+	/** Image build timestamp, from its header */
+	uint64_t timestamp;
+	/** Image load (entry) address */
+	uint32_t load_address;
+	/** Image size, from its header */
+	uint32_t image_size;
+	/** Image CRC32-IEEE, from its header */
+	uint32_t image_crc;
+	/** Reset cause (Zephyr hwinfo RESET_* flags) */
+	uint32_t reset_cause;
+	/** Battery voltage (mV) */
+	uint16_t vbat_mv;
+	/** Booted image (@ref pb_handoff_slot) */
+	uint8_t slot;
+	/** Backup slot state (@ref pb_handoff_backup) */
+	uint8_t backup;
+};
+
+#endif /* PB_HANDOFF_H */
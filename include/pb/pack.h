@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file pack.h
+ * @brief Staged firmware package (firmware to bootloader ABI).
+ *
+ * The firmware downloads update packages to the staging partition (pb,staging
+ * chosen node), then requests their installation by setting the
+ * NEW_FW_AVAILABLE bootbit (or NEW_PRF_AVAILABLE for a PRF package). A
+ * package is a header followed by a payload that decodes to a complete slot
+ * image (firmware header and binary). Packages are created with
+ * scripts/pbpack.py.
+ *
+ * The last erase sector of the staging partition is reserved for the
+ * bootloader install journal, and must not be used nor erased by the firmware
+ * while an installation is requested. Compressed PRF packages are first
+ * decoded to the staging partition, from the sector following the package, so
+ * the partition must have room for both the package and the decoded image.
+ */
+
+#ifndef PB_PACK_H
+#define PB_PACK_H
+
+#include <stdint.h>
+
+/** Package magic number ("PBPK") */
+#define PB_PACK_MAGIC 0x4b504250UL
+
+/** Package format version */
+#define PB_PACK_VERSION 1U
+
+/** Payload encodings */
+enum pb_pack_encoding {
+	/** Payload is the image itself */
+	PB_PACK_ENCODING_RAW = 0,
+	/**
+	 * Payload is the image compressed as a single LZ4 block (sequences
+	 * only, no frame).
+	 */
+	PB_PACK_ENCODING_LZ4 = 1,
+	/**
+	 * Payload is a delta against the image in the other firmware slot,
+	 * see @ref pb_pack_delta_header.
+	 */
+	PB_PACK_ENCODING_DELTA = 2,
+};
+
+/**
+ * @name PB_PACK_DELTA_OP Delta operations
+ *
+ * A delta payload is a @ref pb_pack_delta_header followed by operations. Each
+ * operation is an opcode byte followed by unsigned LEB128 arguments.
+ * @{
+ */
+
+/** Literal: length, followed by length bytes */
+#define PB_PACK_DELTA_OP_LITERAL 0U
+/**
+ * Copy from the source image: length, and source position adjustment
+ * (zigzag encoded, relative to the end of the previous copy)
+ */
+#define PB_PACK_DELTA_OP_COPY    1U
+
+/** @} */
+
+/** Delta payload header */
+struct pb_pack_delta_header {
+	/** Source image size (from the start of the slot) */
+	uint32_t source_length;
+	/** CRC32-IEEE checksum of the source image */
+	uint32_t source_crc;
+};
+
+/** Package header */
+struct pb_pack_header {
+	/** Magic number (@ref PB_PACK_MAGIC) */
+	uint32_t magic;
+	/** Size of the header structure */
+	uint32_t header_length;
+	/** Format version (@ref PB_PACK_VERSION) */
+	uint16_t version;
+	/** Payload encoding (@ref pb_pack_encoding) */
+	uint8_t encoding;
+	/** Reserved, must be 0 */
+	uint8_t reserved;
+	/** Payload size */
+	uint32_t payload_length;
+	/** CRC32-IEEE checksum of the payload */
+	uint32_t payload_crc;
+	/** Decoded image size */
+	uint32_t image_length;
+};
+
+#endif /* PB_PACK_H */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PB_SHA256_H
+#define PB_SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef CONFIG_PB_SHA256_CRYPTO
+#include <zephyr/crypto/crypto.h>
+#endif
+
+/** SHA-256 digest size */
+#define PB_SHA256_SIZE 32U
+
+/** SHA-256 context */
+struct pb_sha256 {
+#if defined(CONFIG_PB_SHA256_SOFTWARE)
+	uint32_t state[8];
+	uint64_t len;
+	uint8_t buf[64];
+#elif defined(CONFIG_PB_SHA256_CRYPTO)
+	struct hash_ctx ctx;
+#endif
+};
+
+/**
+ * @brief Start a SHA-256 computation.
+ *
+ * Every started computation must be completed with pb_sha256_final(), so
+ * that backend resources are released.
+ *
+ * @param ctx Context.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int pb_sha256_init(struct pb_sha256 *ctx);
+
+/**
+ * @brief Feed data to a SHA-256 computation.
+ *
+ * @param ctx Context.
+ * @param data Data.
+ * @param len Length of data.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int pb_sha256_update(struct pb_sha256 *ctx, const void *data, size_t len);
+
+/**
+ * @brief Complete a SHA-256 computation.
+ *
+ * @param ctx Context.
+ * @param[out] digest Digest.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int pb_sha256_final(struct pb_sha256 *ctx, uint8_t digest[PB_SHA256_SIZE]);
+
+#endif /* PB_SHA256_H */
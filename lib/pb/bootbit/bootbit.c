@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+#include <pb/bootbit.h>
+
+#include <pb/bootbit_backend.h>
+
+/* RAM shadow of the boot bits storage, and its last stored value */
+static uint32_t shadow;
+static uint32_t stored;
+
+void pb_bootbit_init(void)
+{
+	shadow = pb_bootbit_backend_load();
+	stored = shadow;
+
+	if (!pb_bootbit_tst(PB_BOOTBIT_INITIALIZED)) {
+		shadow = BIT(PB_BOOTBIT_INITIALIZED);
+		pb_bootbit_commit();
+	}
+}
+
+void pb_bootbit_set(enum pb_bootbit bit)
+{
+	shadow |= BIT(bit);
+}
+
+void pb_bootbit_clr(enum pb_bootbit bit)
+{
+	shadow &= ~BIT(bit);
+}
+
+bool pb_bootbit_tst(enum pb_bootbit bit)
+{
+	return (shadow & BIT(bit)) != 0U;
+}
+
+void pb_bootbit_commit(void)
+{
+	if (shadow == stored) {
+		return;
+	}
+
+	pb_bootbit_backend_store(shadow);
+	stored = shadow;
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include <zephyr/linker/section_tags.h>
+
+#include <pb/bootbit_backend.h>
+
+/* not initialized at startup, so it survives warm resets where RAM is kept */
+static __noinit uint32_t bits_storage;
+
+uint32_t pb_bootbit_backend_load(void)
+{
+	return bits_storage;
+}
+
+void pb_bootbit_backend_store(uint32_t bits)
+{
+	bits_storage = bits;
+}
@@ -3,34 +3,23 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdint.h>
+
 #include <zephyr/arch/cpu.h>
-#include <zephyr/sys/util.h>
 
-#include <pb/bootbit.h>
+#include <pb/bootbit_backend.h>
 
 #include <register.h>
 
 /* Use RTC backup register 2 for boot bits */
 #define RTC_BKP2R offsetof(RTC_TypeDef, BKP2R)
 
-void pb_bootbit_init(void)
-{
-	if (!pb_bootbit_tst(PB_BOOTBIT_INITIALIZED)) {
-		sys_write32(RTC_BASE + RTC_BKP2R, BIT(PB_BOOTBIT_INITIALIZED));
-	}
-}
-
-void pb_bootbit_set(enum pb_bootbit bit)
-{
-	sys_bitfield_set_bit(RTC_BASE + RTC_BKP2R, bit);
-}
-
-void pb_bootbit_clr(enum pb_bootbit bit)
+uint32_t pb_bootbit_backend_load(void)
 {
-	sys_bitfield_clear_bit(RTC_BASE + RTC_BKP2R, bit);
+	return sys_read32(RTC_BASE + RTC_BKP2R);
 }
 
-bool pb_bootbit_tst(enum pb_bootbit bit)
+void pb_bootbit_backend_store(uint32_t bits)
 {
-	return sys_bitfield_test_bit(RTC_BASE + RTC_BKP2R, bit);
+	sys_write32(bits, RTC_BASE + RTC_BKP2R);
 }
@@ -3,34 +3,158 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <errno.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
-size_t pb_cobs_encode(void *dst, const void *src, size_t len)
+#include <zephyr/sys/util.h>
+
+#include <pb/cobs.h>
+
+/* maximum number of data bytes in a block */
+#define COBS_BLOCK_MAX 254U
+
+/* evaluates to non-zero if any byte of w is zero */
+#define HAS_ZERO_BYTE(w) (((w) - 0x01010101UL) & ~(w) & 0x80808080UL)
+
+/* length of the zero-free run at p, up to max bytes */
+static size_t cobs_run_len(const uint8_t *p, size_t max)
 {
-	const char *csrc = src;
-	char *cdst = dst;
-	uint8_t code = 1U;
-	size_t code_idx = 0U;
-	size_t dst_idx = 1U;
-
-	for (size_t src_idx = 0U; src_idx < len; src_idx++) {
-		if (csrc[src_idx] == '\0') {
-			cdst[code_idx] = code;
-			code_idx = dst_idx++;
-			code = 1U;
-		} else {
-			cdst[dst_idx++] = csrc[src_idx];
-			code++;
-			if ((code == 0xFFU) && (src_idx > (len - 1))) {
-				cdst[code_idx] = code;
-				code_idx = dst_idx++;
-				code = 1U;
-			}
+	size_t n = 0U;
+
+	while ((max - n) >= sizeof(uint32_t)) {
+		uint32_t w;
+
+		memcpy(&w, &p[n], sizeof(w));
+		if (HAS_ZERO_BYTE(w) != 0U) {
+			break;
 		}
+
+		n += sizeof(w);
+	}
+
+	while ((n < max) && (p[n] != 0U)) {
+		n++;
 	}
 
-	cdst[code_idx] = code;
+	return n;
+}
+
+size_t pb_cobs_encode(void *dst, const void *src, size_t len)
+{
+	const uint8_t *csrc = src;
+	uint8_t *cdst = dst;
+	size_t src_idx = 0U;
+	size_t dst_idx = 0U;
+
+	while (true) {
+		size_t run = cobs_run_len(&csrc[src_idx], MIN(len - src_idx, COBS_BLOCK_MAX));
+
+		/* memmove: source and destination overlap when encoding in-place */
+		cdst[dst_idx] = (uint8_t)(run + 1U);
+		memmove(&cdst[dst_idx + 1U], &csrc[src_idx], run);
+
+		dst_idx += run + 1U;
+		src_idx += run;
+
+		if (src_idx == len) {
+			break;
+		}
+
+		/* skip the zero ending the block (full blocks do not end with a zero) */
+		if (run < COBS_BLOCK_MAX) {
+			src_idx++;
+		}
+	}
 
 	return dst_idx;
 }
+
+size_t pb_cobs_encode_inplace(void *buf, size_t len)
+{
+	return pb_cobs_encode(buf, (uint8_t *)buf + PB_COBS_OVERHEAD(len), len);
+}
+
+static void cobs_enc_block_out(struct pb_cobs_enc *enc)
+{
+	enc->block[0] = enc->len + 1U;
+	enc->out(enc->block, enc->len + 1U, enc->user_data);
+	enc->len = 0U;
+}
+
+void pb_cobs_enc_init(struct pb_cobs_enc *enc, pb_cobs_out_t out, void *user_data)
+{
+	enc->out = out;
+	enc->user_data = user_data;
+	enc->len = 0U;
+	/* even empty data is encoded as one block */
+	enc->pending = true;
+}
+
+void pb_cobs_enc_update(struct pb_cobs_enc *enc, const void *data, size_t len)
+{
+	const uint8_t *cdata = data;
+
+	while (len > 0U) {
+		size_t run = cobs_run_len(cdata, MIN(len, COBS_BLOCK_MAX - enc->len));
+
+		memcpy(&enc->block[1U + enc->len], cdata, run);
+		enc->len += run;
+		cdata += run;
+		len -= run;
+
+		if (enc->len == COBS_BLOCK_MAX) {
+			/* a full block is not followed by an empty one at the end */
+			cobs_enc_block_out(enc);
+			enc->pending = false;
+		} else if (len > 0U) {
+			/* the run stopped on a zero, which ends the block */
+			cobs_enc_block_out(enc);
+			enc->pending = true;
+			cdata++;
+			len--;
+		} else if (run > 0U) {
+			enc->pending = true;
+		}
+	}
+}
+
+void pb_cobs_enc_finish(struct pb_cobs_enc *enc)
+{
+	if (enc->pending) {
+		cobs_enc_block_out(enc);
+	}
+
+	enc->pending = false;
+}
+
+int pb_cobs_decode(void *dst, const void *src, size_t len)
+{
+	const uint8_t *csrc = src;
+	uint8_t *cdst = dst;
+	size_t src_idx = 0U;
+	size_t dst_idx = 0U;
+
+	while (src_idx < len) {
+		uint8_t code = csrc[src_idx++];
+		size_t run = code - 1U;
+
+		if ((code == 0U) || (run > (len - src_idx)) ||
+		    (cobs_run_len(&csrc[src_idx], run) != run)) {
+			return -EINVAL;
+		}
+
+		memmove(&cdst[dst_idx], &csrc[src_idx], run);
+
+		dst_idx += run;
+		src_idx += run;
+
+		if ((code != 0xFFU) && (src_idx < len)) {
+			cdst[dst_idx++] = 0U;
+		}
+	}
+
+	return (int)dst_idx;
+}
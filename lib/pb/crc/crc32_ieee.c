@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include <pb/crc.h>
+
+#if defined(CONFIG_PB_CRC32_IEEE_NIBBLE)
+#define TABLE_SLICES  1
+#define TABLE_ENTRIES 16
+#elif defined(CONFIG_PB_CRC32_IEEE_TABLE)
+#define TABLE_SLICES  1
+#define TABLE_ENTRIES 256
+#elif defined(CONFIG_PB_CRC32_IEEE_SLICE4)
+#define TABLE_SLICES  4
+#define TABLE_ENTRIES 256
+#elif defined(CONFIG_PB_CRC32_IEEE_SLICE8)
+#define TABLE_SLICES  8
+#define TABLE_ENTRIES 256
+#endif
+
+/* generated at build time, see gen_crc32_table.py */
+extern const uint32_t pb_crc32_ieee_table[TABLE_SLICES][TABLE_ENTRIES];
+
+#define T pb_crc32_ieee_table
+
+/* reflected polynomial */
+#define POLY 0xEDB88320UL
+
+static inline uint32_t crc32_ieee_byte(uint32_t crc, uint8_t b)
+{
+#if TABLE_ENTRIES == 16
+	crc = (crc >> 4) ^ T[0][(crc ^ b) & 0x0FU];
+	crc = (crc >> 4) ^ T[0][(crc ^ (b >> 4)) & 0x0FU];
+
+	return crc;
+#else
+	return (crc >> 8) ^ T[0][(crc ^ b) & 0xFFU];
+#endif
+}
+
+#if TABLE_SLICES == 4
+static inline uint32_t crc32_ieee_word(uint32_t crc, const uint8_t *data)
+{
+	crc ^= sys_le32_to_cpu(*(const uint32_t *)data);
+
+	return T[3][crc & 0xFFU] ^ T[2][(crc >> 8) & 0xFFU] ^ T[1][(crc >> 16) & 0xFFU] ^
+	       T[0][crc >> 24];
+}
+#elif TABLE_SLICES == 8
+static inline uint32_t crc32_ieee_dword(uint32_t crc, const uint8_t *data)
+{
+	uint32_t hi = sys_le32_to_cpu(*(const uint32_t *)(data + 4));
+
+	crc ^= sys_le32_to_cpu(*(const uint32_t *)data);
+
+	return T[7][crc & 0xFFU] ^ T[6][(crc >> 8) & 0xFFU] ^ T[5][(crc >> 16) & 0xFFU] ^
+	       T[4][crc >> 24] ^ T[3][hi & 0xFFU] ^ T[2][(hi >> 8) & 0xFFU] ^
+	       T[1][(hi >> 16) & 0xFFU] ^ T[0][hi >> 24];
+}
+#endif
+
+uint32_t pb_crc32_ieee_update(uint32_t crc, const void *data, size_t len)
+{
+	const uint8_t *p = data;
+
+	crc = ~crc;
+
+#if TABLE_SLICES > 1
+	/* align to a word boundary so that the main loop uses word loads */
+	while ((len > 0U) && (((uintptr_t)p & 0x3U) != 0U)) {
+		crc = crc32_ieee_byte(crc, *p++);
+		len--;
+	}
+
+#if TABLE_SLICES == 8
+	while (len >= 8U) {
+		crc = crc32_ieee_dword(crc, p);
+		p += 8;
+		len -= 8U;
+	}
+#else
+	while (len >= 4U) {
+		crc = crc32_ieee_word(crc, p);
+		p += 4;
+		len -= 4U;
+	}
+#endif
+#endif /* TABLE_SLICES > 1 */
+
+	while (len > 0U) {
+		crc = crc32_ieee_byte(crc, *p++);
+		len--;
+	}
+
+	return ~crc;
+}
+
+/* multiply a and b modulo the polynomial (reflected, x^0 is the MSB) */
+static uint32_t crc32_ieee_multmodp(uint32_t a, uint32_t b)
+{
+	uint32_t m = BIT(31);
+	uint32_t p = 0U;
+
+	while (m != 0U) {
+		if ((a & m) != 0U) {
+			p ^= b;
+		}
+
+		m >>= 1;
+		b = ((b & 1U) != 0U) ? ((b >> 1) ^ POLY) : (b >> 1);
+	}
+
+	return p;
+}
+
+uint32_t pb_crc32_ieee_combine_gen(size_t len2)
+{
+	/* x^8, the operator for one byte */
+	uint32_t x2n = BIT(23);
+	/* x^0 */
+	uint32_t op = BIT(31);
+
+	/* x^(8 * len2), by squaring */
+	for (; len2 > 0U; len2 >>= 1) {
+		if ((len2 & 1U) != 0U) {
+			op = crc32_ieee_multmodp(x2n, op);
+		}
+
+		x2n = crc32_ieee_multmodp(x2n, x2n);
+	}
+
+	return op;
+}
+
+uint32_t pb_crc32_ieee_combine_op(uint32_t crc1, uint32_t crc2, uint32_t op)
+{
+	return crc32_ieee_multmodp(op, crc1) ^ crc2;
+}
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Core Devices LLC
+# SPDX-License-Identifier: Apache-2.0
+
+"""Generate CRC32-IEEE lookup tables."""
+
+import argparse
+from pathlib import Path
+
+POLY = 0xEDB88320
+
+
+def gen_tables(entries, slices):
+    bits = entries.bit_length() - 1
+
+    base = []
+    for i in range(entries):
+        crc = i
+        for _ in range(bits):
+            crc = (crc >> 1) ^ POLY if crc & 1 else crc >> 1
+        base.append(crc)
+
+    tables = [base]
+    for _ in range(1, slices):
+        prev = tables[-1]
+        tables.append([(crc >> 8) ^ base[crc & 0xFF] for crc in prev])
+
+    return tables
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--entries", type=int, choices=(16, 256), required=True)
+    parser.add_argument("--slices", type=int, choices=(1, 4, 8), default=1)
+    parser.add_argument("--output", type=Path, required=True)
+    args = parser.parse_args()
+
+    if args.entries == 16 and args.slices != 1:
+        parser.error("nibble tables cannot be sliced")
+
+    tables = gen_tables(args.entries, args.slices)
+
+    lines = [
+        "/* Generated by gen_crc32_table.py, do not edit */",
+        "",
+        "#include <stdint.h>",
+        "",
+        f"const uint32_t pb_crc32_ieee_table[{args.slices}][{args.entries}] = {{",
+    ]
+    for table in tables:
+        lines.append("\t{")
+        for i in range(0, len(table), 4):
+            row = ", ".join(f"0x{v:08x}UL" for v in table[i : i + 4])
+            lines.append(f"\t\t{row},")
+        lines.append("\t},")
+    lines.append("};")
+    lines.append("")
+
+    args.output.parent.mkdir(parents=True, exist_ok=True)
+    args.output.write_text("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()
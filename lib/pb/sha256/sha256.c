@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include <pb/sha256.h>
+
+#define BLOCK_SIZE 64U
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32U - (n))))
+
+static const uint32_t k[64] = {
+	0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U,
+	0xab1c5ed5U, 0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU,
+	0x9bdc06a7U, 0xc19bf174U, 0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU,
+	0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU, 0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U,
+	0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U, 0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU,
+	0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U, 0xa2bfe8a1U, 0xa81a664bU,
+	0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U, 0x19a4c116U,
+	0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+	0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U,
+	0xc67178f2U,
+};
+
+static void sha256_block(uint32_t state[8], const uint8_t *data)
+{
+	uint32_t w[16];
+	uint32_t a = state[0];
+	uint32_t b = state[1];
+	uint32_t c = state[2];
+	uint32_t d = state[3];
+	uint32_t e = state[4];
+	uint32_t f = state[5];
+	uint32_t g = state[6];
+	uint32_t h = state[7];
+	uint32_t t1;
+	uint32_t t2;
+
+	for (uint32_t i = 0U; i < 64U; i++) {
+		/* message schedule, kept as a 16 word ring */
+		if (i < 16U) {
+			w[i] = sys_get_be32(&data[i * 4U]);
+		} else {
+			uint32_t w2 = w[(i - 2U) & 0xFU];
+			uint32_t w15 = w[(i - 15U) & 0xFU];
+
+			w[i & 0xFU] += (ROTR(w2, 17U) ^ ROTR(w2, 19U) ^ (w2 >> 10)) +
+				       w[(i - 7U) & 0xFU] +
+				       (ROTR(w15, 7U) ^ ROTR(w15, 18U) ^ (w15 >> 3));
+		}
+
+		t1 = h + (ROTR(e, 6U) ^ ROTR(e, 11U) ^ ROTR(e, 25U)) + ((e & f) ^ (~e & g)) + k[i] +
+		     w[i & 0xFU];
+		t2 = (ROTR(a, 2U) ^ ROTR(a, 13U) ^ ROTR(a, 22U)) + ((a & b) ^ (a & c) ^ (b & c));
+
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
+}
+
+int pb_sha256_init(struct pb_sha256 *ctx)
+{
+	static const uint32_t iv[8] = {
+		0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU,
+		0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U,
+	};
+
+	memcpy(ctx->state, iv, sizeof(iv));
+	ctx->len = 0U;
+
+	return 0;
+}
+
+int pb_sha256_update(struct pb_sha256 *ctx, const void *data, size_t len)
+{
+	const uint8_t *p = data;
+	size_t used = ctx->len % BLOCK_SIZE;
+	size_t n;
+
+	ctx->len += len;
+
+	/* complete a partial block first */
+	if (used > 0U) {
+		n = MIN(len, BLOCK_SIZE - used);
+		memcpy(&ctx->buf[used], p, n);
+		p += n;
+		len -= n;
+
+		if ((used + n) < BLOCK_SIZE) {
+			return 0;
+		}
+
+		sha256_block(ctx->state, ctx->buf);
+	}
+
+	/* full blocks are processed in place */
+	while (len >= BLOCK_SIZE) {
+		sha256_block(ctx->state, p);
+		p += BLOCK_SIZE;
+		len -= BLOCK_SIZE;
+	}
+
+	memcpy(ctx->buf, p, len);
+
+	return 0;
+}
+
+int pb_sha256_final(struct pb_sha256 *ctx, uint8_t digest[PB_SHA256_SIZE])
+{
+	size_t used = ctx->len % BLOCK_SIZE;
+	uint64_t bits = ctx->len * 8U;
+
+	ctx->buf[used++] = 0x80U;
+
+	if (used > (BLOCK_SIZE - sizeof(bits))) {
+		memset(&ctx->buf[used], 0, BLOCK_SIZE - used);
+		sha256_block(ctx->state, ctx->buf);
+		used = 0U;
+	}
+
+	memset(&ctx->buf[used], 0, BLOCK_SIZE - sizeof(bits) - used);
+	sys_put_be64(bits, &ctx->buf[BLOCK_SIZE - sizeof(bits)]);
+	sha256_block(ctx->state, ctx->buf);
+
+	for (size_t i = 0U; i < ARRAY_SIZE(ctx->state); i++) {
+		sys_put_be32(ctx->state[i], &digest[i * 4U]);
+	}
+
+	return 0;
+}
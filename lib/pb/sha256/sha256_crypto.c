@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/crypto/crypto.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+
+#include <pb/sha256.h>
+
+static const struct device *hash_dev = DEVICE_DT_GET(DT_CHOSEN(pb_hash));
+
+int pb_sha256_init(struct pb_sha256 *ctx)
+{
+	if (!device_is_ready(hash_dev)) {
+		return -ENODEV;
+	}
+
+	ctx->ctx.flags = CAP_SYNC_OPS | CAP_SEPARATE_IO_BUFS;
+
+	return hash_begin_session(hash_dev, &ctx->ctx, CRYPTO_HASH_ALGO_SHA256);
+}
+
+int pb_sha256_update(struct pb_sha256 *ctx, const void *data, size_t len)
+{
+	struct hash_pkt pkt = {
+		.in_buf = (uint8_t *)data,
+		.in_len = len,
+	};
+
+	return hash_update(&ctx->ctx, &pkt);
+}
+
+int pb_sha256_final(struct pb_sha256 *ctx, uint8_t digest[PB_SHA256_SIZE])
+{
+	struct hash_pkt pkt = {
+		.in_buf = NULL,
+		.in_len = 0U,
+		.out_buf = digest,
+	};
+	int ret;
+
+	ret = hash_compute(&ctx->ctx, &pkt);
+
+	hash_free_session(hash_dev, &ctx->ctx);
+
+	return ret;
+}
@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Core Devices LLC
+# SPDX-License-Identifier: Apache-2.0
+
+"""Create and inspect pblboot slot images.
+
+A slot image is a firmware header followed by the firmware binary, placed at
+the start offset given in the header (see boot/src/firmware.h). Version 2
+headers are followed by a table of CRC32-IEEE digests, one per block of the
+firmware binary, so that the bootloader can stop on the first corrupted block
+and verify parts of the image only. An optional SHA-256 trailer, placed right
+after the firmware binary, is required by bootloaders verifying image hashes.
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+import time
+import zlib
+
+FW_MAGIC = 0x96F3B83D
+FW_HDR_V1_FMT = "<IIQIII"
+FW_HDR_V2_FMT = "<IIQIIIIII"
+FW_HDR_V1_LEN = struct.calcsize(FW_HDR_V1_FMT)
+FW_HDR_V2_LEN = struct.calcsize(FW_HDR_V2_FMT)
+FW_SHA256_MAGIC = 0x48534250
+
+
+def block_digests(binary, block_size):
+    return [
+        zlib.crc32(binary[off : off + block_size]) for off in range(0, len(binary), block_size)
+    ]
+
+
+def image_create(binary, timestamp, start_offset, block_size, table_offset, sha256):
+    if block_size:
+        digests = block_digests(binary, block_size)
+        table = struct.pack(f"<{len(digests)}I", *digests)
+        if table_offset < FW_HDR_V2_LEN:
+            sys.exit("Digest table offset overlaps the header")
+        header = struct.pack(
+            FW_HDR_V2_FMT,
+            FW_MAGIC,
+            FW_HDR_V2_LEN,
+            timestamp,
+            start_offset,
+            len(binary),
+            zlib.crc32(binary),
+            block_size,
+            table_offset,
+            zlib.crc32(table),
+        )
+        header += b"\xff" * (table_offset - len(header))
+    else:
+        table = b""
+        header = struct.pack(
+            FW_HDR_V1_FMT,
+            FW_MAGIC,
+            FW_HDR_V1_LEN,
+            timestamp,
+            start_offset,
+            len(binary),
+            zlib.crc32(binary),
+        )
+
+    if len(header) + len(table) > start_offset:
+        sys.exit(
+            f"Header and digest table ({len(header) + len(table)} bytes) do not fit before "
+            "the start offset, use a larger start offset or block size"
+        )
+
+    image = header + table + b"\xff" * (start_offset - len(header) - len(table)) + binary
+    if sha256:
+        image += struct.pack("<I", FW_SHA256_MAGIC) + hashlib.sha256(binary).digest()
+
+    return image
+
+
+def image_check(image):
+    if len(image) < FW_HDR_V1_LEN:
+        return ["image too small"]
+
+    magic, header_length, timestamp, start_offset, length, crc = struct.unpack_from(
+        FW_HDR_V1_FMT, image
+    )
+    if magic != FW_MAGIC or header_length not in (FW_HDR_V1_LEN, FW_HDR_V2_LEN):
+        return ["no valid firmware header"]
+
+    print(f"version:      {1 if header_length == FW_HDR_V1_LEN else 2}")
+    print(f"timestamp:    {timestamp}")
+    print(f"start offset: 0x{start_offset:x}")
+    print(f"length:       {length}")
+
+    if start_offset + length > len(image):
+        return ["image is truncated"]
+
+    binary = image[start_offset : start_offset + length]
+    errors = []
+    if zlib.crc32(binary) != crc:
+        errors.append("image CRC mismatch")
+
+    trailer = image[start_offset + length : start_offset + length + 36]
+    if len(trailer) == 36 and struct.unpack_from("<I", trailer)[0] == FW_SHA256_MAGIC:
+        print(f"sha256:       {trailer[4:].hex()}")
+        if trailer[4:] != hashlib.sha256(binary).digest():
+            errors.append("image SHA-256 mismatch")
+
+    if header_length == FW_HDR_V2_LEN:
+        block_size, table_offset, table_crc = struct.unpack_from(FW_HDR_V2_FMT, image)[6:]
+        count = (length + block_size - 1) // block_size if block_size else 0
+        print(f"block size:   {block_size} ({count} blocks)")
+        print(f"table offset: 0x{table_offset:x}")
+        table_end = table_offset + 4 * count
+        if not block_size or table_offset < header_length or table_end > start_offset:
+            return errors + ["invalid digest table"]
+
+        table = image[table_offset:table_end]
+        if zlib.crc32(table) != table_crc:
+            errors.append("digest table CRC mismatch")
+
+        digests = struct.unpack(f"<{count}I", table)
+        for i, digest in enumerate(block_digests(binary, block_size)):
+            if digest != digests[i]:
+                errors.append(f"block {i} digest mismatch")
+
+    return errors
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    create = sub.add_parser("create", help="Create a slot image from a firmware binary")
+    create.add_argument("binary", help="Firmware binary")
+    create.add_argument("output", help="Output slot image")
+    create.add_argument("-t", "--timestamp", type=int, help="Build timestamp (default: now)")
+    create.add_argument(
+        "-s",
+        "--start-offset",
+        type=lambda x: int(x, 0),
+        default=0x1000,
+        help="Offset of the firmware binary in the image (default: 0x1000)",
+    )
+    create.add_argument(
+        "-b",
+        "--block-size",
+        type=lambda x: int(x, 0),
+        default=4096,
+        help="Digest table block size, 0 for a v1 header (default: 4096)",
+    )
+    create.add_argument(
+        "--table-offset",
+        type=lambda x: int(x, 0),
+        default=0x100,
+        help="Offset of the digest table in the image (default: 0x100)",
+    )
+    create.add_argument(
+        "--sha256", action="store_true", help="Append a SHA-256 trailer to the image"
+    )
+
+    info = sub.add_parser("info", help="Show and verify a slot image")
+    info.add_argument("image", help="Slot image")
+
+    args = parser.parse_args()
+
+    if args.command == "create":
+        with open(args.binary, "rb") as f:
+            binary = f.read()
+
+        timestamp = args.timestamp if args.timestamp is not None else int(time.time())
+        image = image_create(
+            binary, timestamp, args.start_offset, args.block_size, args.table_offset, args.sha256
+        )
+
+        with open(args.output, "wb") as f:
+            f.write(image)
+
+        print(f"{args.output}: {len(image)} bytes (v{2 if args.block_size else 1} header)")
+    else:
+        with open(args.image, "rb") as f:
+            image = f.read()
+
+        errors = image_check(image)
+        for error in errors:
+            print(f"error: {error}")
+
+        sys.exit(1 if errors else 0)
+
+
+if __name__ == "__main__":
+    main()
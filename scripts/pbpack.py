@@ -0,0 +1,277 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Core Devices LLC
+# SPDX-License-Identifier: Apache-2.0
+
+"""Create pblboot firmware packages.
+
+A package wraps a slot image (firmware header and binary) so that it can be
+staged by the firmware and installed by the bootloader, see include/pb/pack.h.
+The payload can optionally be LZ4 compressed (single block, no frame), or be a
+delta against the image currently installed in the other slot.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+PACK_MAGIC = 0x4B504250
+PACK_VERSION = 1
+PACK_HDR_FMT = "<IIHBBIII"
+
+ENCODING_RAW = 0
+ENCODING_LZ4 = 1
+ENCODING_DELTA = 2
+
+DELTA_OP_LITERAL = 0
+DELTA_OP_COPY = 1
+DELTA_HDR_FMT = "<II"
+DELTA_BLOCK = 8
+DELTA_MIN_COPY = 16
+
+FW_MAGIC = 0x96F3B83D
+FW_HDR_FMT = "<IIQIII"
+FW_HDR_V2_LEN = 40
+
+LZ4_MIN_MATCH = 4
+LZ4_LAST_LITERALS = 5
+LZ4_MFLIMIT = 12
+LZ4_MAX_DISTANCE = 0xFFFF
+
+
+def lz4_len(out, n):
+    while n >= 0xFF:
+        out.append(0xFF)
+        n -= 0xFF
+    out.append(n)
+
+
+def lz4_sequence(out, literals, distance=0, match_len=0):
+    lit_len = len(literals)
+    match_code = match_len - LZ4_MIN_MATCH if distance else 0
+    out.append((min(lit_len, 15) << 4) | min(match_code, 15))
+    if lit_len >= 15:
+        lz4_len(out, lit_len - 15)
+    out += literals
+    if distance:
+        out += distance.to_bytes(2, "little")
+        if match_code >= 15:
+            lz4_len(out, match_code - 15)
+
+
+def lz4_compress(data):
+    """Greedy LZ4 block compressor."""
+    out = bytearray()
+    table = {}
+    anchor = 0
+    pos = 0
+    limit = len(data) - LZ4_MFLIMIT
+    while pos < limit:
+        key = data[pos : pos + LZ4_MIN_MATCH]
+        ref = table.get(key)
+        table[key] = pos
+        if ref is None or pos - ref > LZ4_MAX_DISTANCE:
+            pos += 1
+            continue
+
+        match_len = LZ4_MIN_MATCH
+        max_len = len(data) - LZ4_LAST_LITERALS - pos
+        while match_len < max_len and data[ref + match_len] == data[pos + match_len]:
+            match_len += 1
+
+        lz4_sequence(out, data[anchor:pos], pos - ref, match_len)
+        pos += match_len
+        anchor = pos
+
+    lz4_sequence(out, data[anchor:])
+    return bytes(out)
+
+
+def lz4_decompress(data):
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        token = data[pos]
+        pos += 1
+        lit_len = token >> 4
+        if lit_len == 15:
+            while True:
+                b = data[pos]
+                pos += 1
+                lit_len += b
+                if b != 0xFF:
+                    break
+        out += data[pos : pos + lit_len]
+        pos += lit_len
+        if pos == len(data):
+            break
+        distance = int.from_bytes(data[pos : pos + 2], "little")
+        pos += 2
+        match_len = token & 0x0F
+        if match_len == 15:
+            while True:
+                b = data[pos]
+                pos += 1
+                match_len += b
+                if b != 0xFF:
+                    break
+        for _ in range(match_len + LZ4_MIN_MATCH):
+            out.append(out[-distance])
+    return bytes(out)
+
+
+def uleb128(out, n):
+    while n >= 0x80:
+        out.append((n & 0x7F) | 0x80)
+        n >>= 7
+    out.append(n)
+
+
+def uleb128_get(data, pos):
+    n = 0
+    shift = 0
+    while True:
+        b = data[pos]
+        pos += 1
+        n |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return n, pos
+
+
+def match_len(a, i, b, j):
+    """Length of the common run of a[i:] and b[j:]."""
+    n = 0
+    while a[i + n : i + n + 256] == b[j + n : j + n + 256] and i + n + 256 <= len(a):
+        n += 256
+    while i + n < len(a) and j + n < len(b) and a[i + n] == b[j + n]:
+        n += 1
+    return n
+
+
+def delta_encode(old, new):
+    """Greedy delta made of literals and copies from the old image."""
+    index = {}
+    for j in range(0, len(old) - DELTA_BLOCK + 1, 4):
+        index.setdefault(old[j : j + DELTA_BLOCK], j)
+
+    out = bytearray(struct.pack(DELTA_HDR_FMT, len(old), zlib.crc32(old)))
+    src_pos = 0
+    lit_start = 0
+    i = 0
+    while i <= len(new) - DELTA_BLOCK:
+        key = new[i : i + DELTA_BLOCK]
+        j = src_pos if old[src_pos : src_pos + DELTA_BLOCK] == key else index.get(key)
+        if j is None:
+            i += 1
+            continue
+
+        back = 0
+        while i - back > lit_start and j - back > 0 and new[i - back - 1] == old[j - back - 1]:
+            back += 1
+        length = back + match_len(new, i, old, j)
+        if length < DELTA_MIN_COPY:
+            i += 1
+            continue
+
+        i -= back
+        j -= back
+        if i > lit_start:
+            out.append(DELTA_OP_LITERAL)
+            uleb128(out, i - lit_start)
+            out += new[lit_start:i]
+
+        adj = j - src_pos
+        out.append(DELTA_OP_COPY)
+        uleb128(out, length)
+        uleb128(out, (adj << 1) if adj >= 0 else ((-adj) << 1) - 1)
+
+        src_pos = j + length
+        i += length
+        lit_start = i
+
+    if lit_start < len(new):
+        out.append(DELTA_OP_LITERAL)
+        uleb128(out, len(new) - lit_start)
+        out += new[lit_start:]
+
+    return bytes(out)
+
+
+def delta_decode(old, data):
+    out = bytearray()
+    pos = struct.calcsize(DELTA_HDR_FMT)
+    src_pos = 0
+    while pos < len(data):
+        op = data[pos]
+        length, pos = uleb128_get(data, pos + 1)
+        if op == DELTA_OP_LITERAL:
+            out += data[pos : pos + length]
+            pos += length
+        else:
+            adj, pos = uleb128_get(data, pos)
+            src_pos += -((adj + 1) >> 1) if adj & 1 else adj >> 1
+            out += old[src_pos : src_pos + length]
+            src_pos += length
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("image", help="Slot image (firmware header and binary)")
+    parser.add_argument("output", help="Output package")
+    parser.add_argument("-e", "--encoding", choices=("raw", "lz4", "delta"), default="lz4")
+    parser.add_argument("-b", "--base", help="Slot image the delta applies to (delta only)")
+    args = parser.parse_args()
+
+    if (args.encoding == "delta") != (args.base is not None):
+        sys.exit("A base image must be given for (and only for) delta packages")
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+
+    if len(image) < struct.calcsize(FW_HDR_FMT):
+        sys.exit("Image too small")
+
+    magic, header_length, _, start_offset, length, _ = struct.unpack_from(FW_HDR_FMT, image)
+    if magic != FW_MAGIC or header_length not in (struct.calcsize(FW_HDR_FMT), FW_HDR_V2_LEN):
+        sys.exit("Image has no valid firmware header")
+    if start_offset + length > len(image):
+        sys.exit("Image is truncated")
+
+    if args.encoding == "lz4":
+        encoding = ENCODING_LZ4
+        payload = lz4_compress(image)
+        if lz4_decompress(payload) != image:
+            sys.exit("LZ4 round-trip check failed")
+    elif args.encoding == "delta":
+        encoding = ENCODING_DELTA
+        with open(args.base, "rb") as f:
+            base = f.read()
+        payload = delta_encode(base, image)
+        if delta_decode(base, payload) != image:
+            sys.exit("Delta round-trip check failed")
+    else:
+        encoding = ENCODING_RAW
+        payload = image
+
+    header = struct.pack(
+        PACK_HDR_FMT,
+        PACK_MAGIC,
+        struct.calcsize(PACK_HDR_FMT),
+        PACK_VERSION,
+        encoding,
+        0,
+        len(payload),
+        zlib.crc32(payload),
+        len(image),
+    )
+
+    with open(args.output, "wb") as f:
+        f.write(header + payload)
+
+    print(f"{args.image}: {len(image)} -> {len(payload)} bytes ({args.encoding})")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Core Devices LLC
+# SPDX-License-Identifier: Apache-2.0
+
+"""Decode pblboot Pulse logging frames, including dictionary based logs.
+
+Frames are read from a serial port or a raw capture file. Text log frames
+(single line or batches of length prefixed lines) are printed as is, dictionary log frames are decoded with Zephyr's dictionary
+parser (ZEPHYR_BASE/scripts/logging/dictionary) and the build log database.
+"""
+
+import argparse
+import os
+import sys
+import zlib
+
+FRAME_DELIMITER = 0x55
+PULSE_PUSH = b"\x50\x21"
+PULSE_PROTO_LOGGING = b"\x00\x03"
+MSG_TYPE_TEXT = 1
+MSG_TYPE_DICT = 2
+MSG_TYPE_TEXT_BATCH = 3
+TEXT_HDR_LEN = 35
+DICT_HDR_LEN = 7
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            raise ValueError("invalid COBS data")
+        out += data[i : i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def frames(stream):
+    buf = bytearray()
+    while True:
+        chunk = stream.read(1)
+        if not chunk:
+            return
+        if chunk[0] == FRAME_DELIMITER:
+            if buf:
+                yield bytes(buf)
+            buf.clear()
+        else:
+            # zero and delimiter are swapped on the wire
+            buf.append(FRAME_DELIMITER if chunk[0] == 0 else chunk[0])
+
+
+def batch_records(data):
+    """Split a batch payload in its length prefixed records."""
+    pos = 0
+    while pos < len(data):
+        length = data[pos]
+        yield data[pos + 1 : pos + 1 + length]
+        pos += 1 + length
+
+
+def get_parser(database):
+    zephyr_base = os.environ.get("ZEPHYR_BASE")
+    if zephyr_base is None:
+        sys.exit("ZEPHYR_BASE must be set to decode dictionary logs")
+
+    sys.path.insert(0, os.path.join(zephyr_base, "scripts", "logging", "dictionary"))
+    import dictionary_parser  # pylint: disable=import-outside-toplevel
+    from dictionary_parser.log_database import LogDatabase  # pylint: disable=import-outside-toplevel
+
+    db = LogDatabase.read_json_database(database)
+    if db is None:
+        sys.exit(f"Cannot open log database {database}")
+
+    return dictionary_parser.get_parser(db)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("input", help="Serial port or raw capture file")
+    parser.add_argument("-d", "--database", help="Log dictionary database (log_dictionary.json)")
+    parser.add_argument("-b", "--baudrate", type=int, default=1000000)
+    args = parser.parse_args()
+
+    log_parser = get_parser(args.database) if args.database else None
+
+    if os.path.isfile(args.input):
+        stream = open(args.input, "rb")  # pylint: disable=consider-using-with
+    else:
+        import serial  # pylint: disable=import-outside-toplevel
+
+        stream = serial.Serial(args.input, args.baudrate)
+
+    for frame in frames(stream):
+        try:
+            msg = cobs_decode(frame)
+        except ValueError:
+            print("<invalid frame>", file=sys.stderr)
+            continue
+
+        if len(msg) < DICT_HDR_LEN + 4:
+            continue
+
+        msg, crc = msg[:-4], int.from_bytes(msg[-4:], "little")
+        if zlib.crc32(msg) != crc:
+            print("<CRC mismatch>", file=sys.stderr)
+            continue
+
+        if msg[0:2] != PULSE_PUSH or msg[2:4] != PULSE_PROTO_LOGGING:
+            continue
+
+        if msg[6] == MSG_TYPE_TEXT:
+            print(msg[TEXT_HDR_LEN:].decode(errors="replace"))
+        elif msg[6] == MSG_TYPE_TEXT_BATCH:
+            for record in batch_records(msg[TEXT_HDR_LEN:]):
+                print(record.decode(errors="replace"))
+        elif msg[6] == MSG_TYPE_DICT:
+            if log_parser is None:
+                print("<dictionary log, no database given>", file=sys.stderr)
+                continue
+            log_parser.parse_log_data(msg[DICT_HDR_LEN:])
+
+
+if __name__ == "__main__":
+    main()
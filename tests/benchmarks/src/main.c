@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Hot path micro-benchmarks of pblboot: image reads, validation, slot
+ * selection, CRC, SHA-256 and COBS. Results are printed one per line, in CSV
+ * format: `bench,<name>,<mode>,<buf_size>,<buf_count>,<bytes>,<cycles>,<ns>,
+ * <kib_s>`, and `bench,done` once all benchmarks have run. The mode and
+ * buffer columns describe how images are read (see image.h).
+ */
+
+#include "firmware.h"
+#include "image.h"
+#include "valcache.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys_clock.h>
+#include <zephyr/timing/timing.h>
+
+#include <pb/bootbit.h>
+#include <pb/cobs.h>
+#include <pb/crc.h>
+#include <pb/sha256.h>
+
+#ifdef CONFIG_FLASH_SIMULATOR
+#include "test_image.h"
+#endif
+
+LOG_MODULE_REGISTER(pblboot, CONFIG_PBLBOOT_LOG_LEVEL);
+
+#define SLOT0_ADDR DT_REG_ADDR(DT_CHOSEN(pb_slot0))
+#define SLOT0_SIZE DT_REG_SIZE(DT_CHOSEN(pb_slot0))
+#define SLOT1_ADDR DT_REG_ADDR(DT_CHOSEN(pb_slot1))
+#define SLOT1_SIZE DT_REG_SIZE(DT_CHOSEN(pb_slot1))
+
+#define COBS_LEN 1024U
+
+/* images written for the selection benchmark, on simulated flash */
+#define SELECT_IMAGE_LEN        MIN(KB(512), MIN(SLOT0_SIZE, SLOT1_SIZE) - KB(4))
+#define SELECT_IMAGE_BLOCK_SIZE KB(4)
+
+#if defined(CONFIG_PB_IMAGE_ACCESS_MMAP)
+#define READ_MODE "mmap"
+#elif defined(CONFIG_PB_FLASH_READ_DMA)
+#define READ_MODE "dma"
+#else
+#define READ_MODE "sync"
+#endif
+
+#ifdef CONFIG_PB_FLASH_READ_BUF_COUNT
+#define READ_BUF_COUNT CONFIG_PB_FLASH_READ_BUF_COUNT
+#else
+#define READ_BUF_COUNT 1
+#endif
+
+#if defined(CONFIG_PB_SHA256_CRYPTO)
+#define SHA256_BACKEND "crypto"
+#else
+#define SHA256_BACKEND "sw"
+#endif
+
+/* partial slot sizes, the whole slot is measured too */
+static const uint32_t image_sizes[] = {
+	KB(4),
+	KB(64),
+	KB(512),
+};
+
+static uint8_t cobs_src[COBS_LEN];
+static uint8_t cobs_dst[PB_COBS_MAX_ENC_SIZE(COBS_LEN)];
+
+/* deterministic pseudo-random data, so runs are comparable */
+static void bench_fill_random(uint8_t *buf, size_t len)
+{
+	uint32_t state = 0x12345678U;
+
+	for (size_t i = 0U; i < len; i++) {
+		state = state * 1103515245U + 12345U;
+		buf[i] = (uint8_t)(state >> 16);
+	}
+}
+
+static void bench_report(const char *name, uint32_t bytes, timing_t start, timing_t end)
+{
+	uint64_t cycles = timing_cycles_get(&start, &end);
+	uint64_t ns = timing_cycles_to_ns(cycles);
+	uint64_t kib_s = 0U;
+
+	if (ns > 0U) {
+		kib_s = ((uint64_t)bytes * NSEC_PER_SEC) / (ns * 1024U);
+	}
+
+	printk("bench,%s,%s,%d,%d,%" PRIu32 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n", name,
+	       READ_MODE, CONFIG_PB_FLASH_READ_BUF_SIZE, READ_BUF_COUNT, bytes, cycles, ns,
+	       kib_s);
+}
+
+static int bench_read_discard(const uint8_t *data, size_t len, void *user_data)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+	ARG_UNUSED(user_data);
+
+	return 0;
+}
+
+/* image reads alone, the difference with validate is the CRC cost */
+static void bench_read(void)
+{
+	timing_t start;
+	timing_t end;
+	int ret;
+
+	start = timing_counter_get();
+	ret = pb_image_stream(SLOT0_ADDR, SLOT0_SIZE, bench_read_discard, NULL);
+	end = timing_counter_get();
+
+	if (ret < 0) {
+		LOG_ERR("Read benchmark failed (err %d)", ret);
+		return;
+	}
+
+	bench_report("read", SLOT0_SIZE, start, end);
+}
+
+static int bench_crc_update(const uint8_t *data, size_t len, void *user_data)
+{
+	uint32_t *crc = user_data;
+
+	*crc = pb_crc32_ieee_update(*crc, data, len);
+
+	return 0;
+}
+
+static void bench_validate_one(uint32_t size)
+{
+	uint32_t crc = 0U;
+	timing_t start;
+	timing_t end;
+	int ret;
+
+	start = timing_counter_get();
+	ret = pb_image_stream(SLOT0_ADDR, size, bench_crc_update, &crc);
+	end = timing_counter_get();
+
+	if (ret < 0) {
+		LOG_ERR("Validation benchmark failed (err %d)", ret);
+		return;
+	}
+
+	bench_report("validate", size, start, end);
+}
+
+static void bench_validate(void)
+{
+	ARRAY_FOR_EACH(image_sizes, i) {
+		if (image_sizes[i] < SLOT0_SIZE) {
+			bench_validate_one(image_sizes[i]);
+		}
+	}
+
+	bench_validate_one(SLOT0_SIZE);
+}
+
+/* length of the image validated by the last selection */
+static uint32_t bench_selected_len(void)
+{
+	static const uint32_t slot_addrs[] = {SLOT0_ADDR, SLOT1_ADDR};
+	static const uint32_t slot_sizes[] = {SLOT0_SIZE, SLOT1_SIZE};
+	struct firmware_header hdr;
+	uint8_t slot;
+
+	if ((pb_firmware_selected_slot(&slot) < 0) ||
+	    (pb_firmware_header_get(slot_addrs[slot], slot_sizes[slot], &hdr) < 0)) {
+		return 0U;
+	}
+
+	return hdr.length;
+}
+
+static int bench_select_one(const char *name)
+{
+	timing_t start;
+	timing_t end;
+	int ret;
+
+	start = timing_counter_get();
+	ret = pb_firmware_select();
+	end = timing_counter_get();
+
+	if (ret < 0) {
+		LOG_ERR("Selection benchmark failed (err %d)", ret);
+		return ret;
+	}
+
+	bench_report(name, bench_selected_len(), start, end);
+
+	return 0;
+}
+
+#ifdef CONFIG_FLASH_SIMULATOR
+static int bench_select_images_write(void)
+{
+	const struct test_image imgs[] = {
+		{
+			.timestamp = 2U,
+			.length = SELECT_IMAGE_LEN,
+			.block_size = SELECT_IMAGE_BLOCK_SIZE,
+			.seed = 0U,
+		},
+		{
+			.timestamp = 1U,
+			.length = SELECT_IMAGE_LEN,
+			.block_size = SELECT_IMAGE_BLOCK_SIZE,
+			.seed = 1U,
+		},
+	};
+	int ret;
+
+	ret = test_image_write(SLOT0_ADDR, &imgs[0], NULL);
+	if (ret == 0) {
+		ret = test_image_write(SLOT1_ADDR, &imgs[1], NULL);
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Failed to write benchmark images (err %d)", ret);
+	}
+
+	return ret;
+}
+#else
+/* on hardware, the firmware already in the slots is selected */
+static int bench_select_images_write(void)
+{
+	return 0;
+}
+#endif /* CONFIG_FLASH_SIMULATOR */
+
+/*
+ * Slot selection as on a first boot after an update, then as on a warm reset
+ * where the validation cache (if enabled) is used.
+ */
+static void bench_select(void)
+{
+	if (bench_select_images_write() < 0) {
+		return;
+	}
+
+	pb_valcache_flash_written();
+
+	if (bench_select_one("select_full") == 0) {
+		(void)bench_select_one(IS_ENABLED(CONFIG_PB_VALIDATION_CACHE) ? "select_cached"
+									     : "select_uncached");
+	}
+}
+
+static void bench_crc(void)
+{
+	timing_t start;
+	timing_t end;
+	uint32_t crc;
+
+	bench_fill_random(cobs_src, sizeof(cobs_src));
+
+	start = timing_counter_get();
+	crc = pb_crc32_ieee(cobs_src, sizeof(cobs_src));
+	end = timing_counter_get();
+
+	ARG_UNUSED(crc);
+
+	bench_report("crc32", sizeof(cobs_src), start, end);
+}
+
+#ifdef CONFIG_PB_SHA256
+struct bench_digest {
+	uint32_t crc;
+	struct pb_sha256 sha256;
+};
+
+static int bench_digest_update(const uint8_t *data, size_t len, void *user_data)
+{
+	struct bench_digest *digest = user_data;
+
+	digest->crc = pb_crc32_ieee_update(digest->crc, data, len);
+
+	return pb_sha256_update(&digest->sha256, data, len);
+}
+
+static void bench_sha256(void)
+{
+	uint8_t out[PB_SHA256_SIZE];
+	struct bench_digest digest;
+	timing_t start;
+	timing_t end;
+	int ret;
+
+	bench_fill_random(cobs_src, sizeof(cobs_src));
+
+	start = timing_counter_get();
+	ret = pb_sha256_init(&digest.sha256);
+	if (ret == 0) {
+		(void)pb_sha256_update(&digest.sha256, cobs_src, sizeof(cobs_src));
+		ret = pb_sha256_final(&digest.sha256, out);
+	}
+	end = timing_counter_get();
+
+	if (ret < 0) {
+		LOG_ERR("SHA-256 benchmark failed (err %d)", ret);
+		return;
+	}
+
+	bench_report("sha256_" SHA256_BACKEND, sizeof(cobs_src), start, end);
+
+	/* CRC and SHA-256 computed in a single pass, as done on validation */
+	start = timing_counter_get();
+	digest.crc = 0U;
+	ret = pb_sha256_init(&digest.sha256);
+	if (ret == 0) {
+		ret = pb_image_stream(SLOT0_ADDR, SLOT0_SIZE, bench_digest_update, &digest);
+		(void)pb_sha256_final(&digest.sha256, out);
+	}
+	end = timing_counter_get();
+
+	if (ret < 0) {
+		LOG_ERR("SHA-256 validation benchmark failed (err %d)", ret);
+		return;
+	}
+
+	bench_report("validate_sha256_" SHA256_BACKEND, SLOT0_SIZE, start, end);
+}
+#endif /* CONFIG_PB_SHA256 */
+
+static void bench_cobs_one(const char *enc_name, const char *dec_name)
+{
+	timing_t start;
+	timing_t end;
+	size_t enc_len;
+
+	start = timing_counter_get();
+	enc_len = pb_cobs_encode(cobs_dst, cobs_src, sizeof(cobs_src));
+	end = timing_counter_get();
+
+	bench_report(enc_name, sizeof(cobs_src), start, end);
+
+	start = timing_counter_get();
+	(void)pb_cobs_decode(cobs_src, cobs_dst, enc_len);
+	end = timing_counter_get();
+
+	bench_report(dec_name, enc_len, start, end);
+}
+
+static void bench_cobs(void)
+{
+	memset(cobs_src, 0xAA, sizeof(cobs_src));
+	bench_cobs_one("cobs_enc_nozero", "cobs_dec_nozero");
+
+	memset(cobs_src, 0x00, sizeof(cobs_src));
+	bench_cobs_one("cobs_enc_zero", "cobs_dec_zero");
+
+	bench_fill_random(cobs_src, sizeof(cobs_src));
+	bench_cobs_one("cobs_enc_random", "cobs_dec_random");
+}
+
+int main(void)
+{
+	int ret;
+
+	pb_bootbit_init();
+
+	ret = pb_firmware_init();
+	if (ret < 0) {
+		LOG_ERR("Failed to initialize firmware module (err %d)", ret);
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("bench,name,mode,buf_size,buf_count,bytes,cycles,ns,kib_s\n");
+
+	bench_read();
+	bench_validate();
+	bench_select();
+	bench_crc();
+#ifdef CONFIG_PB_SHA256
+	bench_sha256();
+#endif
+	bench_cobs();
+
+	timing_stop();
+
+	printk("bench,done\n");
+
+	return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "firmware.h"
+#include "firmware_test.h"
+#include "image.h"
+#include "test_image.h"
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/retention/retention.h>
+#include <zephyr/ztest.h>
+
+#include <pb/bootbit.h>
+#include <pb/bootbit_backend.h>
+
+/* the flash image module, renamed at build time */
+int pb_image_flash_stream(uint32_t offset, uint32_t len, pb_image_stream_cb_t cb,
+			  void *user_data);
+
+static uint32_t streamed;
+
+int pb_image_stream(uint32_t offset, uint32_t len, pb_image_stream_cb_t cb, void *user_data)
+{
+	streamed += len;
+
+	return pb_image_flash_stream(offset, len, cb, user_data);
+}
+
+uint32_t test_image_streamed(void)
+{
+	uint32_t ret = streamed;
+
+	streamed = 0U;
+
+	return ret;
+}
+
+void test_cold_boot(void)
+{
+	zassert_ok(test_flash_erase(SLOT0_ADDR, TEST_IMAGE_START_OFFSET));
+	zassert_ok(test_flash_erase(SLOT1_ADDR, TEST_IMAGE_START_OFFSET));
+
+#ifdef CONFIG_PB_VALIDATION_CACHE
+	zassert_ok(retention_clear(DEVICE_DT_GET(DT_CHOSEN(pb_valcache))));
+#endif
+
+	pb_bootbit_backend_store(BIT(PB_BOOTBIT_INITIALIZED));
+
+	test_warm_boot();
+}
+
+void test_warm_boot(void)
+{
+	pb_bootbit_init();
+
+	zassert_ok(pb_firmware_init());
+
+	(void)test_image_streamed();
+}
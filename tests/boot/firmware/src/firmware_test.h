@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_BOOT_FIRMWARE_FIRMWARE_TEST_H_
+#define TESTS_BOOT_FIRMWARE_FIRMWARE_TEST_H_
+
+#include <stdint.h>
+
+#include <zephyr/devicetree.h>
+
+#define SLOT0_ADDR DT_REG_ADDR(DT_CHOSEN(pb_slot0))
+#define SLOT0_SIZE DT_REG_SIZE(DT_CHOSEN(pb_slot0))
+#define SLOT1_ADDR DT_REG_ADDR(DT_CHOSEN(pb_slot1))
+#define SLOT1_SIZE DT_REG_SIZE(DT_CHOSEN(pb_slot1))
+
+/**
+ * @brief Start from empty slots, after a cold boot.
+ *
+ * Slot headers are erased, retained memory is cleared and boot bits are
+ * reset to their initialized state.
+ */
+void test_cold_boot(void);
+
+/**
+ * @brief Simulate a warm reset.
+ *
+ * Boot bits and the firmware module are initialized again, retained memory
+ * is kept.
+ */
+void test_warm_boot(void);
+
+/**
+ * @brief Get the number of image bytes streamed since the last call.
+ *
+ * @return Number of bytes passed to pb_image_stream().
+ */
+uint32_t test_image_streamed(void);
+
+#endif /* TESTS_BOOT_FIRMWARE_FIRMWARE_TEST_H_ */
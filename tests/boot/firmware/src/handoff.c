@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "firmware.h"
+#include "firmware_test.h"
+#include "handoff.h"
+#include "test_image.h"
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/retention/retention.h>
+#include <zephyr/ztest.h>
+
+#include <pb/handoff.h>
+
+#define LOAD_ADDRESS 0x12345678U
+
+static const struct device *retention = DEVICE_DT_GET(DT_CHOSEN(pb_handoff));
+
+static const struct test_image img = {
+	.timestamp = 1U,
+	.length = KB(16),
+	.block_size = KB(4),
+	.seed = 1U,
+};
+
+static struct firmware_header hdr;
+
+static void handoff_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	test_cold_boot();
+	zassert_ok(retention_clear(retention));
+
+	zassert_ok(test_image_write(SLOT0_ADDR, &img, &hdr));
+}
+
+static void handoff_get(struct pb_handoff *handoff)
+{
+	zassert_true(retention_is_valid(retention) > 0);
+	zassert_ok(retention_read(retention, 0U, (uint8_t *)handoff, sizeof(*handoff)));
+
+	zassert_equal(handoff->version, PB_HANDOFF_VERSION);
+	zassert_equal(handoff->slot, PB_HANDOFF_SLOT_0);
+	zassert_equal(handoff->load_address, LOAD_ADDRESS);
+	zassert_equal(handoff->timestamp, hdr.timestamp);
+	zassert_equal(handoff->image_size, hdr.length);
+	zassert_equal(handoff->image_crc, hdr.crc);
+}
+
+ZTEST(handoff, test_verified)
+{
+	struct pb_handoff handoff;
+
+	pb_handoff_image(PB_HANDOFF_SLOT_0, LOAD_ADDRESS, &hdr, false);
+	pb_handoff_commit();
+
+	handoff_get(&handoff);
+	zassert_true((handoff.flags & PB_HANDOFF_FLAG_VERIFIED) != 0U);
+	zassert_true((handoff.flags & PB_HANDOFF_FLAG_CACHED) == 0U);
+}
+
+/* the body of an image trusted from the validation cache was not checked */
+ZTEST(handoff, test_cached_not_verified)
+{
+	struct pb_handoff handoff;
+
+	pb_handoff_image(PB_HANDOFF_SLOT_0, LOAD_ADDRESS, &hdr, false);
+	pb_handoff_image(PB_HANDOFF_SLOT_0, LOAD_ADDRESS, &hdr, true);
+	pb_handoff_commit();
+
+	handoff_get(&handoff);
+	zassert_true((handoff.flags & PB_HANDOFF_FLAG_CACHED) != 0U);
+	zassert_true((handoff.flags & PB_HANDOFF_FLAG_VERIFIED) == 0U);
+}
+
+ZTEST_SUITE(handoff, NULL, NULL, handoff_before, NULL, NULL);
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "firmware.h"
+#include "firmware_test.h"
+#include "test_image.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#define IMAGE_LEN        KB(64)
+#define IMAGE_BLOCK_SIZE KB(4)
+#define IMAGE_BLOCKS     (IMAGE_LEN / IMAGE_BLOCK_SIZE)
+#define TABLE_LEN        (IMAGE_BLOCKS * sizeof(uint32_t))
+
+/* image trailer, if any */
+#define TRAILER_LEN (IS_ENABLED(CONFIG_PB_IMAGE_SHA256) ? sizeof(struct firmware_sha256) : 0U)
+
+static const struct test_image img_v1 = {
+	.timestamp = 1U,
+	.length = IMAGE_LEN,
+	.block_size = 0U,
+	.seed = 1U,
+};
+
+static const struct test_image img_v2 = {
+	.timestamp = 2U,
+	.length = IMAGE_LEN,
+	.block_size = IMAGE_BLOCK_SIZE,
+	.seed = 2U,
+};
+
+/* headers as written */
+static struct firmware_header hdr_v1;
+static struct firmware_header hdr_v2;
+
+static void header_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	test_cold_boot();
+
+	zassert_ok(test_image_write(SLOT0_ADDR, &img_v1, &hdr_v1));
+	zassert_ok(test_image_write(SLOT1_ADDR, &img_v2, &hdr_v2));
+}
+
+static uint32_t block_addr(uint32_t address, uint32_t block)
+{
+	return address + TEST_IMAGE_START_OFFSET + (block * IMAGE_BLOCK_SIZE);
+}
+
+ZTEST(header, test_get_v1)
+{
+	struct firmware_header hdr;
+
+	zassert_ok(pb_firmware_header_get(SLOT0_ADDR, SLOT0_SIZE, &hdr));
+
+	zassert_equal(hdr.header_length, PBLBOOT_HEADER_V1_LENGTH);
+	zassert_equal(hdr.timestamp, hdr_v1.timestamp);
+	zassert_equal(hdr.start_offset, TEST_IMAGE_START_OFFSET);
+	zassert_equal(hdr.length, IMAGE_LEN);
+	zassert_equal(hdr.crc, hdr_v1.crc);
+
+	/* read from erased flash past the header, then zeroed */
+	zassert_equal(hdr.block_size, 0U);
+	zassert_equal(hdr.table_offset, 0U);
+	zassert_equal(hdr.table_crc, 0U);
+}
+
+ZTEST(header, test_get_v2)
+{
+	struct firmware_header hdr;
+
+	zassert_ok(pb_firmware_header_get(SLOT1_ADDR, SLOT1_SIZE, &hdr));
+
+	zassert_equal(hdr.header_length, PBLBOOT_HEADER_V2_LENGTH);
+	zassert_equal(hdr.block_size, IMAGE_BLOCK_SIZE);
+	zassert_equal(hdr.table_offset, TEST_IMAGE_TABLE_OFFSET);
+	zassert_mem_equal(&hdr, &hdr_v2, sizeof(hdr));
+}
+
+ZTEST(header, test_get_invalid)
+{
+	struct firmware_header hdr;
+
+	zassert_ok(test_flash_corrupt(SLOT0_ADDR));
+	zassert_equal(pb_firmware_header_get(SLOT0_ADDR, SLOT0_SIZE, &hdr), -EINVAL);
+
+	zassert_ok(test_flash_erase(SLOT1_ADDR, TEST_IMAGE_START_OFFSET));
+	zassert_equal(pb_firmware_header_get(SLOT1_ADDR, SLOT1_SIZE, &hdr), -EINVAL);
+}
+
+/* the binary and its trailer must fit in the slot */
+ZTEST(header, test_get_slot_size)
+{
+	uint32_t size = TEST_IMAGE_START_OFFSET + IMAGE_LEN + TRAILER_LEN;
+	struct firmware_header hdr;
+
+	zassert_ok(pb_firmware_header_get(SLOT0_ADDR, size, &hdr));
+	zassert_equal(pb_firmware_header_get(SLOT0_ADDR, size - 1U, &hdr), -EINVAL);
+
+	zassert_ok(pb_firmware_header_get(SLOT1_ADDR, size, &hdr));
+	zassert_equal(pb_firmware_header_get(SLOT1_ADDR, size - 1U, &hdr), -EINVAL);
+}
+
+ZTEST(header, test_check_header_length)
+{
+	static const uint32_t lengths[] = {
+		0U,
+		PBLBOOT_HEADER_V1_LENGTH - 4U,
+		PBLBOOT_HEADER_V1_LENGTH + 4U,
+		PBLBOOT_HEADER_V2_LENGTH + 4U,
+		UINT32_MAX,
+	};
+	struct firmware_header hdr;
+
+	ARRAY_FOR_EACH(lengths, i) {
+		hdr = hdr_v2;
+		hdr.header_length = lengths[i];
+		zassert_equal(pb_firmware_header_check(&hdr, SLOT1_SIZE), -EINVAL, "length %u",
+			      lengths[i]);
+	}
+}
+
+ZTEST(header, test_check_bounds)
+{
+	const struct firmware_header *hdrs[] = {&hdr_v1, &hdr_v2};
+	struct firmware_header hdr;
+
+	ARRAY_FOR_EACH(hdrs, i) {
+		/* binary overlapping the header */
+		hdr = *hdrs[i];
+		hdr.start_offset = hdr.header_length - 1U;
+		zassert_equal(pb_firmware_header_check(&hdr, SLOT0_SIZE), -EINVAL, "hdr %zu", i);
+
+		/* offset and length wrapping around */
+		hdr = *hdrs[i];
+		hdr.length = UINT32_MAX - hdr.start_offset + 1U;
+		zassert_equal(pb_firmware_header_check(&hdr, SLOT0_SIZE), -EINVAL, "hdr %zu", i);
+
+		hdr = *hdrs[i];
+		hdr.start_offset = UINT32_MAX;
+		zassert_equal(pb_firmware_header_check(&hdr, SLOT0_SIZE), -EINVAL, "hdr %zu", i);
+	}
+}
+
+ZTEST(header, test_check_table)
+{
+	struct firmware_header hdr;
+
+	hdr = hdr_v2;
+	hdr.block_size = 0U;
+	zassert_equal(pb_firmware_header_check(&hdr, SLOT1_SIZE), -EINVAL);
+
+	/* table overlapping the header */
+	hdr = hdr_v2;
+	hdr.table_offset = PBLBOOT_HEADER_V2_LENGTH - 1U;
+	zassert_equal(pb_firmware_header_check(&hdr, SLOT1_SIZE), -EINVAL);
+
+	/* table overlapping the binary, or right before it */
+	hdr = hdr_v2;
+	hdr.table_offset = TEST_IMAGE_START_OFFSET - TABLE_LEN + 1U;
+	zassert_equal(pb_firmware_header_check(&hdr, SLOT1_SIZE), -EINVAL);
+
+	hdr = hdr_v2;
+	hdr.table_offset = TEST_IMAGE_START_OFFSET - TABLE_LEN;
+	zassert_ok(pb_firmware_header_check(&hdr, SLOT1_SIZE));
+
+	/* more blocks than the table holds */
+	hdr = hdr_v2;
+	hdr.table_offset = TEST_IMAGE_START_OFFSET - TABLE_LEN;
+	hdr.block_size = 1U;
+	zassert_equal(pb_firmware_header_check(&hdr, SLOT1_SIZE), -EINVAL);
+}
+
+ZTEST(header, test_validate)
+{
+	zassert_ok(pb_firmware_validate(SLOT0_ADDR, &hdr_v1));
+	zassert_ok(pb_firmware_validate(SLOT1_ADDR, &hdr_v2));
+
+	zassert_ok(test_flash_corrupt(block_addr(SLOT0_ADDR, IMAGE_BLOCKS - 1U)));
+	zassert_ok(test_flash_corrupt(block_addr(SLOT1_ADDR, IMAGE_BLOCKS - 1U)));
+
+	zassert_equal(pb_firmware_validate(SLOT0_ADDR, &hdr_v1), -EIO);
+	zassert_equal(pb_firmware_validate(SLOT1_ADDR, &hdr_v2), -EIO);
+}
+
+/* version 2 images stop on the first bad block, version 1 ones are read whole */
+ZTEST(header, test_validate_early_abort)
+{
+	zassert_ok(test_flash_corrupt(block_addr(SLOT0_ADDR, 0U)));
+	zassert_ok(test_flash_corrupt(block_addr(SLOT1_ADDR, 0U)));
+
+	(void)test_image_streamed();
+
+	zassert_equal(pb_firmware_validate(SLOT0_ADDR, &hdr_v1), -EIO);
+	zassert_equal(test_image_streamed(), IMAGE_LEN);
+
+	zassert_equal(pb_firmware_validate(SLOT1_ADDR, &hdr_v2), -EIO);
+	zassert_equal(test_image_streamed(), TABLE_LEN + IMAGE_BLOCK_SIZE);
+}
+
+ZTEST(header, test_validate_corrupt_table)
+{
+	zassert_ok(test_flash_corrupt(SLOT1_ADDR + TEST_IMAGE_TABLE_OFFSET + TABLE_LEN - 1U));
+
+	zassert_equal(pb_firmware_validate(SLOT1_ADDR, &hdr_v2), -EIO);
+	zassert_equal(pb_firmware_validate_range(SLOT1_ADDR, &hdr_v2, 0U, IMAGE_BLOCK_SIZE), -EIO);
+}
+
+ZTEST(header, test_validate_range)
+{
+	zassert_ok(test_flash_corrupt(block_addr(SLOT1_ADDR, 3U) + 1U));
+
+	(void)test_image_streamed();
+
+	/* only blocks overlapping the range are read */
+	zassert_ok(pb_firmware_validate_range(SLOT1_ADDR, &hdr_v2, 0U, 3U * IMAGE_BLOCK_SIZE));
+	zassert_equal(test_image_streamed(), TABLE_LEN + (3U * IMAGE_BLOCK_SIZE));
+
+	zassert_ok(pb_firmware_validate_range(SLOT1_ADDR, &hdr_v2, 4U * IMAGE_BLOCK_SIZE,
+					      IMAGE_LEN));
+	zassert_equal(pb_firmware_validate_range(SLOT1_ADDR, &hdr_v2,
+						 (3U * IMAGE_BLOCK_SIZE) - 1U, 1U),
+		      0);
+	zassert_equal(pb_firmware_validate_range(SLOT1_ADDR, &hdr_v2,
+						 (3U * IMAGE_BLOCK_SIZE) - 1U, 2U),
+		      -EIO);
+
+	/* empty or out of the binary */
+	zassert_ok(pb_firmware_validate_range(SLOT1_ADDR, &hdr_v2, 0U, 0U));
+	zassert_ok(pb_firmware_validate_range(SLOT1_ADDR, &hdr_v2, IMAGE_LEN, IMAGE_BLOCK_SIZE));
+}
+
+/* version 1 images have no block digests, the range is ignored */
+ZTEST(header, test_validate_range_v1)
+{
+	zassert_ok(pb_firmware_validate_range(SLOT0_ADDR, &hdr_v1, 0U, IMAGE_BLOCK_SIZE));
+
+	zassert_ok(test_flash_corrupt(block_addr(SLOT0_ADDR, 3U)));
+
+	zassert_equal(pb_firmware_validate_range(SLOT0_ADDR, &hdr_v1, 0U, IMAGE_BLOCK_SIZE),
+		      -EIO);
+}
+
+ZTEST_SUITE(header, NULL, NULL, header_before, NULL, NULL);
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "firmware.h"
+#include "firmware_test.h"
+#include "test_image.h"
+
+#include <errno.h>
+#include <stddef.h>
+
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#define IMAGE_LEN        KB(64)
+#define IMAGE_BLOCK_SIZE KB(4)
+
+/* header area (hashed for the validation cache) and a single whole image */
+#define ONE_IMAGE_READ_MAX ((2U * TEST_IMAGE_START_OFFSET) + IMAGE_LEN)
+
+enum slot_state {
+	SLOT_EMPTY,
+	SLOT_BAD_HEADER,
+	SLOT_CORRUPT,
+	SLOT_VALID,
+	SLOT_STATE_COUNT,
+};
+
+static const char *const slot_state_names[] = {
+	[SLOT_EMPTY] = "empty",
+	[SLOT_BAD_HEADER] = "bad header",
+	[SLOT_CORRUPT] = "corrupt",
+	[SLOT_VALID] = "valid",
+};
+
+static const uint32_t slot_addrs[] = {SLOT0_ADDR, SLOT1_ADDR};
+
+static void select_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	test_cold_boot();
+}
+
+static struct test_image slot_image(uint8_t slot, uint64_t timestamp, uint32_t block_size)
+{
+	struct test_image img = {
+		.timestamp = timestamp,
+		.length = IMAGE_LEN,
+		.block_size = block_size,
+		.seed = slot + 1U,
+	};
+
+	return img;
+}
+
+static void slot_prepare(uint8_t slot, enum slot_state state, uint64_t timestamp)
+{
+	struct test_image img = slot_image(slot, timestamp, IMAGE_BLOCK_SIZE);
+	uint32_t address = slot_addrs[slot];
+	uint32_t body_mid = address + TEST_IMAGE_START_OFFSET + (IMAGE_LEN / 2U);
+
+	if (state == SLOT_EMPTY) {
+		return;
+	}
+
+	zassert_ok(test_image_write(address, &img, NULL));
+
+	if (state == SLOT_BAD_HEADER) {
+		/* magic number */
+		zassert_ok(test_flash_corrupt(address));
+	} else if (state == SLOT_CORRUPT) {
+		zassert_ok(test_flash_corrupt(body_mid));
+	}
+}
+
+/* newest slot with a valid header first, first one with a valid image wins */
+static int slot_expected(const enum slot_state *states, uint8_t newest)
+{
+	const uint8_t order[] = {newest, 1U - newest};
+
+	ARRAY_FOR_EACH(order, i) {
+		if (states[order[i]] == SLOT_VALID) {
+			return order[i];
+		}
+	}
+
+	return -ENOENT;
+}
+
+static void select_check(int expected, const char *msg)
+{
+	uint8_t slot;
+	int ret;
+
+	ret = pb_firmware_select();
+	if (expected < 0) {
+		zassert_equal(ret, expected, "%s: err %d", msg, ret);
+		zassert_equal(pb_firmware_selected_slot(&slot), -ENOENT, "%s", msg);
+		return;
+	}
+
+	zassert_ok(ret, "%s: err %d", msg, ret);
+	zassert_ok(pb_firmware_selected_slot(&slot), "%s", msg);
+	zassert_equal(slot, expected, "%s: slot%u selected", msg, slot);
+}
+
+/* every combination of slot states, with either slot holding the newest image */
+ZTEST(select, test_combinations)
+{
+	enum slot_state states[ARRAY_SIZE(slot_addrs)];
+	char msg[64];
+
+	for (int s0 = 0; s0 < SLOT_STATE_COUNT; s0++) {
+		for (int s1 = 0; s1 < SLOT_STATE_COUNT; s1++) {
+			for (uint8_t newest = 0U; newest < 2U; newest++) {
+				states[0] = (enum slot_state)s0;
+				states[1] = (enum slot_state)s1;
+
+				snprintk(msg, sizeof(msg), "slot0 %s, slot1 %s, slot%u newest",
+					 slot_state_names[s0], slot_state_names[s1], newest);
+
+				test_cold_boot();
+				slot_prepare(0U, states[0], newest == 0U ? 2U : 1U);
+				slot_prepare(1U, states[1], newest == 1U ? 2U : 1U);
+
+				select_check(slot_expected(states, newest), msg);
+			}
+		}
+	}
+}
+
+ZTEST(select, test_equal_timestamps)
+{
+	slot_prepare(0U, SLOT_VALID, 1U);
+	slot_prepare(1U, SLOT_VALID, 1U);
+
+	select_check(0, "equal timestamps");
+}
+
+/* only the newest image is validated when it is valid */
+ZTEST(select, test_backup_not_read)
+{
+	slot_prepare(0U, SLOT_VALID, 1U);
+	slot_prepare(1U, SLOT_VALID, 2U);
+
+	select_check(1, "slot1 newest");
+	zassert_true(test_image_streamed() <= ONE_IMAGE_READ_MAX);
+}
+
+ZTEST(select, test_fallback_reads_both)
+{
+	slot_prepare(0U, SLOT_VALID, 1U);
+	slot_prepare(1U, SLOT_CORRUPT, 2U);
+
+	select_check(0, "slot1 newest, corrupt");
+	zassert_true(test_image_streamed() > ONE_IMAGE_READ_MAX);
+}
+
+ZTEST(select, test_bad_header_length)
+{
+	slot_prepare(0U, SLOT_VALID, 1U);
+	slot_prepare(1U, SLOT_VALID, 2U);
+
+	zassert_ok(
+		test_flash_corrupt(SLOT1_ADDR + offsetof(struct firmware_header, header_length)));
+
+	select_check(0, "slot1 header length");
+}
+
+ZTEST(select, test_corrupt_table)
+{
+	slot_prepare(0U, SLOT_VALID, 2U);
+	slot_prepare(1U, SLOT_VALID, 1U);
+
+	zassert_ok(test_flash_corrupt(SLOT0_ADDR + TEST_IMAGE_TABLE_OFFSET));
+
+	select_check(1, "slot0 digest table");
+}
+
+/* version 1 and version 2 images are compared by timestamp alone */
+ZTEST(select, test_mixed_versions)
+{
+	struct test_image v1 = slot_image(0U, 2U, 0U);
+
+	zassert_ok(test_image_write(SLOT0_ADDR, &v1, NULL));
+	slot_prepare(1U, SLOT_VALID, 1U);
+
+	select_check(0, "slot0 v1 newest");
+
+	test_cold_boot();
+	v1.timestamp = 1U;
+	zassert_ok(test_image_write(SLOT0_ADDR, &v1, NULL));
+	slot_prepare(1U, SLOT_VALID, 2U);
+
+	select_check(1, "slot1 v2 newest");
+
+	test_cold_boot();
+	v1.timestamp = 2U;
+	zassert_ok(test_image_write(SLOT0_ADDR, &v1, NULL));
+	zassert_ok(test_flash_corrupt(SLOT0_ADDR + TEST_IMAGE_START_OFFSET));
+	slot_prepare(1U, SLOT_VALID, 1U);
+
+	select_check(1, "slot0 v1 newest, corrupt");
+}
+
+ZTEST_SUITE(select, NULL, NULL, select_before, NULL, NULL);
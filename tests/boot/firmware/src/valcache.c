@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "firmware.h"
+#include "firmware_test.h"
+#include "test_image.h"
+#include "valcache.h"
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/retention/retention.h>
+#include <zephyr/ztest.h>
+
+#include <pb/bootbit.h>
+
+#define IMAGE_LEN        KB(64)
+#define IMAGE_BLOCK_SIZE KB(4)
+
+/* header area, digest table and spot checked blocks */
+#define CACHED_READ_MAX                                                                            \
+	(TEST_IMAGE_START_OFFSET + KB(1) +                                                         \
+	 (CONFIG_PB_VALIDATION_SPOT_CHECK_BLOCKS * IMAGE_BLOCK_SIZE))
+
+static const struct test_image img_new = {
+	.timestamp = 2U,
+	.length = IMAGE_LEN,
+	.block_size = IMAGE_BLOCK_SIZE,
+	.seed = 1U,
+};
+
+static const struct test_image img_old = {
+	.timestamp = 1U,
+	.length = IMAGE_LEN,
+	.block_size = IMAGE_BLOCK_SIZE,
+	.seed = 2U,
+};
+
+static struct firmware_header hdr;
+
+static void valcache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	test_cold_boot();
+
+	zassert_ok(test_image_write(SLOT0_ADDR, &img_new, &hdr));
+	zassert_ok(test_image_write(SLOT1_ADDR, &img_old, NULL));
+}
+
+static uint8_t select_slot(void)
+{
+	uint8_t slot;
+
+	zassert_ok(pb_firmware_select());
+	zassert_ok(pb_firmware_selected_slot(&slot));
+
+	return slot;
+}
+
+#ifdef CONFIG_PB_VALIDATION_CACHE
+ZTEST(valcache, test_lookup)
+{
+	zassert_false(pb_valcache_lookup(0U, &hdr, 0x1234U));
+
+	pb_valcache_store(0U, &hdr, 0x1234U);
+
+	zassert_true(pb_valcache_lookup(0U, &hdr, 0x1234U));
+	zassert_false(pb_valcache_lookup(1U, &hdr, 0x1234U));
+
+	/* header area changed, e.g. the digest table */
+	zassert_false(pb_valcache_lookup(0U, &hdr, 0x1235U));
+
+	hdr.timestamp++;
+	zassert_false(pb_valcache_lookup(0U, &hdr, 0x1234U));
+}
+
+ZTEST(valcache, test_invalidate)
+{
+	pb_valcache_store(0U, &hdr, 0x1234U);
+	pb_valcache_store(1U, &hdr, 0x1234U);
+	pb_valcache_invalidate(0U);
+
+	zassert_false(pb_valcache_lookup(0U, &hdr, 0x1234U));
+	zassert_true(pb_valcache_lookup(1U, &hdr, 0x1234U));
+}
+
+ZTEST(valcache, test_flash_written)
+{
+	pb_valcache_store(0U, &hdr, 0x1234U);
+	pb_valcache_flash_written();
+
+	zassert_false(pb_valcache_lookup(0U, &hdr, 0x1234U));
+
+	pb_valcache_store(0U, &hdr, 0x1234U);
+
+	zassert_true(pb_valcache_lookup(0U, &hdr, 0x1234U));
+}
+
+ZTEST(valcache, test_max_hits)
+{
+	if (CONFIG_PB_VALIDATION_CACHE_MAX_HITS == 0) {
+		ztest_test_skip();
+	}
+
+	pb_valcache_store(0U, &hdr, 0x1234U);
+
+	for (int i = 0; i < CONFIG_PB_VALIDATION_CACHE_MAX_HITS; i++) {
+		zassert_true(pb_valcache_lookup(0U, &hdr, 0x1234U), "hit %d", i);
+	}
+
+	zassert_false(pb_valcache_lookup(0U, &hdr, 0x1234U));
+}
+
+ZTEST(valcache, test_warm_boot_keeps_entries)
+{
+	pb_valcache_store(0U, &hdr, 0x1234U);
+
+	test_warm_boot();
+
+	zassert_true(pb_valcache_lookup(0U, &hdr, 0x1234U));
+}
+
+ZTEST(valcache, test_cold_boot_drops_entries)
+{
+	pb_valcache_store(0U, &hdr, 0x1234U);
+
+	zassert_ok(retention_clear(DEVICE_DT_GET(DT_CHOSEN(pb_valcache))));
+	test_warm_boot();
+
+	zassert_false(pb_valcache_lookup(0U, &hdr, 0x1234U));
+}
+
+ZTEST(valcache, test_new_fw_drops_entries)
+{
+	static const enum pb_bootbit bits[] = {
+		PB_BOOTBIT_NEW_FW_INSTALLED,
+		PB_BOOTBIT_NEW_FW_UPDATE_IN_PROGRESS,
+	};
+
+	ARRAY_FOR_EACH(bits, i) {
+		pb_valcache_store(0U, &hdr, 0x1234U);
+
+		pb_bootbit_set(bits[i]);
+		pb_bootbit_commit();
+		test_warm_boot();
+
+		zassert_false(pb_valcache_lookup(0U, &hdr, 0x1234U), "bit %d", bits[i]);
+
+		pb_bootbit_clr(bits[i]);
+		pb_bootbit_commit();
+	}
+}
+
+/* an entry is not trusted for more than the maximum number of hits in a row */
+ZTEST(valcache, test_boot_reads_max_hits)
+{
+	if (CONFIG_PB_VALIDATION_CACHE_MAX_HITS == 0) {
+		ztest_test_skip();
+	}
+
+	zassert_equal(select_slot(), 0U);
+
+	for (int i = 0; i < CONFIG_PB_VALIDATION_CACHE_MAX_HITS; i++) {
+		test_warm_boot();
+		zassert_equal(select_slot(), 0U);
+		zassert_true(test_image_streamed() <= CACHED_READ_MAX, "boot %d", i);
+	}
+
+	test_warm_boot();
+	zassert_equal(select_slot(), 0U);
+	zassert_true(test_image_streamed() >= IMAGE_LEN);
+}
+
+#endif /* CONFIG_PB_VALIDATION_CACHE */
+
+/*
+ * Flash traffic of slot selection on successive boots: only the first boot
+ * reads the whole image when the cache is enabled, the following ones read
+ * the header area and a few spot checked blocks.
+ */
+ZTEST(valcache, test_boot_reads)
+{
+	uint32_t full;
+	uint32_t cached;
+
+	zassert_equal(select_slot(), 0U);
+	full = test_image_streamed();
+	zassert_true(full >= IMAGE_LEN);
+
+	test_warm_boot();
+	zassert_equal(select_slot(), 0U);
+	cached = test_image_streamed();
+
+	TC_PRINT("slot selection read %u bytes (first boot), %u bytes (warm reset)\n", full,
+		 cached);
+
+	if (IS_ENABLED(CONFIG_PB_VALIDATION_CACHE)) {
+		zassert_true(cached <= CACHED_READ_MAX);
+	} else {
+		zassert_equal(cached, full);
+	}
+}
+
+/*
+ * A body corruption outside of the spot checked blocks goes unnoticed while
+ * the entry is trusted, it is found as soon as the bootloader writes flash.
+ */
+ZTEST(valcache, test_corruption_after_write)
+{
+	uint32_t addr = SLOT0_ADDR + TEST_IMAGE_START_OFFSET + IMAGE_LEN - 1U;
+
+	zassert_equal(select_slot(), 0U);
+
+	zassert_ok(test_flash_corrupt(addr));
+
+	test_warm_boot();
+	zassert_equal(select_slot(), IS_ENABLED(CONFIG_PB_VALIDATION_CACHE) ? 0U : 1U);
+
+	pb_valcache_flash_written();
+	zassert_equal(select_slot(), 1U);
+}
+
+ZTEST_SUITE(valcache, NULL, NULL, valcache_before, NULL, NULL);
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Core Devices LLC
+# SPDX-License-Identifier: Apache-2.0
+
+"""Generate the firmware binaries of the install tests.
+
+The old binary mixes incompressible data, runs, repeated text and chunks
+repeated far back (further than the install buffers), so that LZ4 packages
+exercise all back-reference paths. The new binary is the old one with a few
+bytes changed, insertions and deletions, like a typical firmware update.
+"""
+
+import argparse
+import random
+from pathlib import Path
+
+TEXT = b"pblboot firmware update test data, "
+
+
+def gen_old(rng, size):
+    out = bytearray()
+    while len(out) < size:
+        kind = rng.randrange(4)
+        n = rng.randrange(256, 4096)
+        if kind == 0:
+            out += rng.randbytes(n)
+        elif kind == 1:
+            out += bytes([rng.randrange(256)]) * n
+        elif kind == 2:
+            out += (TEXT * (n // len(TEXT) + 1))[:n]
+        elif len(out) > n:
+            start = rng.randrange(len(out) - n)
+            out += out[start : start + n]
+
+    return bytes(out[:size])
+
+
+def gen_new(rng, old):
+    new = bytearray(old)
+
+    # changed bytes, as when a few constants or addresses move
+    for _ in range(32):
+        pos = rng.randrange(len(new) - 16)
+        new[pos : pos + 16] = rng.randbytes(16)
+
+    # inserted, removed and appended code
+    pos = rng.randrange(len(new))
+    new[pos:pos] = rng.randbytes(3000)
+    pos = rng.randrange(len(new) - 5000)
+    del new[pos : pos + 5000]
+    new += rng.randbytes(10000)
+
+    return bytes(new)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--size", type=int, default=160 * 1024)
+    parser.add_argument("--old", type=Path, required=True)
+    parser.add_argument("--new", type=Path, required=True)
+    args = parser.parse_args()
+
+    rng = random.Random(1)
+
+    old = gen_old(rng, args.size)
+    new = gen_new(rng, old)
+
+    args.old.write_bytes(old)
+    args.new.write_bytes(new)
+
+
+if __name__ == "__main__":
+    main()
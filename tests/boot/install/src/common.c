@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "firmware.h"
+#include "install_test.h"
+#include "test_flash.h"
+#include "test_image.h"
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/retention/retention.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include <pb/bootbit.h>
+#include <pb/bootbit_backend.h>
+
+/* flash used by the tests in each partition, images are smaller */
+#define AREA_SIZE         KB(256)
+/* packages and decoded PRF images */
+#define STAGING_AREA_SIZE KB(512)
+
+#define CMP_CHUNK 256U
+
+static const uint8_t old_img_data[] = {
+#include "old.img.inc"
+};
+
+static const uint8_t new_img_data[] = {
+#include "new.img.inc"
+};
+
+static const uint8_t raw_pack_data[] = {
+#include "raw.pack.inc"
+};
+
+static const uint8_t lz4_pack_data[] = {
+#include "lz4.pack.inc"
+};
+
+static const uint8_t delta_pack_data[] = {
+#include "delta.pack.inc"
+};
+
+#define TEST_BLOB(name) {.data = name##_data, .len = sizeof(name##_data)}
+
+const struct test_blob old_img = TEST_BLOB(old_img);
+const struct test_blob new_img = TEST_BLOB(new_img);
+const struct test_blob raw_pack = TEST_BLOB(raw_pack);
+const struct test_blob lz4_pack = TEST_BLOB(lz4_pack);
+const struct test_blob delta_pack = TEST_BLOB(delta_pack);
+
+static const struct device *flash = DEVICE_DT_GET(DT_CHOSEN(zephyr_flash_controller));
+
+static uint32_t feeds;
+
+/* there is no watchdog to feed in tests, feeds are counted */
+int pb_watchdog_feed(void)
+{
+	feeds++;
+
+	return 0;
+}
+
+uint32_t test_watchdog_feeds(void)
+{
+	uint32_t ret = feeds;
+
+	feeds = 0U;
+
+	return ret;
+}
+
+void test_cold_boot(void)
+{
+	struct test_flash_stats stats;
+
+	zassert_ok(test_flash_erase(SLOT0_ADDR, AREA_SIZE));
+	zassert_ok(test_flash_erase(SLOT1_ADDR, AREA_SIZE));
+	zassert_ok(test_flash_erase(PRF_ADDR, AREA_SIZE));
+	zassert_ok(test_flash_erase(STAGING_ADDR, STAGING_AREA_SIZE));
+	zassert_ok(test_flash_erase(JOURNAL_ADDR, KB(4)));
+
+	test_blob_write(SLOT0_ADDR, &old_img);
+
+#ifdef CONFIG_PB_VALIDATION_CACHE
+	zassert_ok(retention_clear(DEVICE_DT_GET(DT_CHOSEN(pb_valcache))));
+#endif
+
+	pb_bootbit_backend_store(BIT(PB_BOOTBIT_INITIALIZED));
+
+	test_reboot();
+
+	test_flash_stats_get(&stats);
+	(void)test_watchdog_feeds();
+}
+
+void test_reboot(void)
+{
+	pb_bootbit_init();
+
+	zassert_ok(pb_firmware_init());
+}
+
+void test_blob_write(uint32_t address, const struct test_blob *blob)
+{
+	zassert_ok(flash_write(flash, address, blob->data, blob->len));
+}
+
+bool test_blob_equal(uint32_t address, const struct test_blob *blob)
+{
+	uint8_t buf[CMP_CHUNK];
+	size_t n;
+
+	for (size_t off = 0U; off < blob->len; off += n) {
+		n = MIN(sizeof(buf), blob->len - off);
+
+		zassert_ok(flash_read(flash, address + off, buf, n));
+		if (memcmp(buf, &blob->data[off], n) != 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool test_journal_cleared(void)
+{
+	uint8_t buf[CMP_CHUNK];
+
+	zassert_ok(flash_read(flash, JOURNAL_ADDR, buf, sizeof(buf)));
+
+	for (size_t i = 0U; i < sizeof(buf); i++) {
+		if (buf[i] != flash_get_parameters(flash)->erase_value) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void test_install_request(const struct test_blob *pack, bool prf)
+{
+	struct test_flash_stats stats;
+
+	test_blob_write(STAGING_ADDR, pack);
+
+	pb_bootbit_set(prf ? PB_BOOTBIT_NEW_PRF_AVAILABLE : PB_BOOTBIT_NEW_FW_AVAILABLE);
+	pb_bootbit_commit();
+
+	test_flash_stats_get(&stats);
+	(void)test_watchdog_feeds();
+}
+
+uint8_t test_selected_slot(void)
+{
+	uint8_t slot;
+
+	zassert_ok(pb_firmware_select());
+	zassert_ok(pb_firmware_selected_slot(&slot));
+
+	return slot;
+}
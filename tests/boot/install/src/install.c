@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "firmware.h"
+#include "install.h"
+#include "install_test.h"
+#include "test_flash.h"
+#include "test_image.h"
+
+#include <errno.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include <pb/bootbit.h>
+
+/* erase sectors of the new image (4 KiB on native_sim) */
+#define NEW_IMG_SECTORS DIV_ROUND_UP(new_img.len, KB(4))
+
+static void install_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	test_cold_boot();
+}
+
+/* install the new image into slot1, next to the old one in slot0 */
+static void install_check(const struct test_blob *pack)
+{
+	test_install_request(pack, false);
+
+	zassert_ok(pb_install_firmware());
+
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_NEW_FW_AVAILABLE));
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_NEW_FW_UPDATE_IN_PROGRESS));
+	zassert_true(pb_bootbit_tst(PB_BOOTBIT_NEW_FW_INSTALLED));
+	zassert_true(test_journal_cleared());
+
+	zassert_true(test_blob_equal(SLOT1_ADDR, &new_img));
+	zassert_true(test_blob_equal(SLOT0_ADDR, &old_img));
+
+	zassert_equal(test_selected_slot(), 1U);
+}
+
+ZTEST(install, test_nothing_requested)
+{
+	struct test_flash_stats stats;
+
+	zassert_false(pb_install_pending());
+	zassert_ok(pb_install_firmware());
+	zassert_ok(pb_install_prf());
+
+	test_flash_stats_get(&stats);
+	zassert_equal(stats.writes, 0U);
+	zassert_equal(stats.erases, 0U);
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_NEW_FW_INSTALLED));
+}
+
+ZTEST(install, test_raw)
+{
+	install_check(&raw_pack);
+}
+
+ZTEST(install, test_lz4)
+{
+	install_check(&lz4_pack);
+}
+
+ZTEST(install, test_delta)
+{
+	install_check(&delta_pack);
+}
+
+/*
+ * Blank sectors are programmed without being erased: only the journal is
+ * erased, when started and once cleared. Each sector is followed by a
+ * journal mark, and the image header is written last.
+ */
+ZTEST(install, test_blank_target)
+{
+	struct test_flash_stats stats;
+
+	install_check(&raw_pack);
+
+	test_flash_stats_get(&stats);
+	zassert_equal(stats.erases, 2U);
+	zassert_equal(stats.writes, 1U + (2U * NEW_IMG_SECTORS) + 1U);
+}
+
+/* sectors already holding the image are neither erased nor programmed */
+ZTEST(install, test_unchanged_sectors)
+{
+	struct test_flash_stats stats;
+
+	install_check(&raw_pack);
+
+	/* header sector lost, slot1 is not bootable */
+	zassert_ok(test_flash_erase(SLOT1_ADDR, TEST_IMAGE_START_OFFSET));
+	zassert_equal(test_selected_slot(), 0U);
+
+	install_check(&raw_pack);
+
+	test_flash_stats_get(&stats);
+	zassert_equal(stats.erases, 2U);
+	zassert_equal(stats.writes, 1U + NEW_IMG_SECTORS + 1U + 1U);
+}
+
+ZTEST(install, test_dirty_target)
+{
+	struct test_flash_stats stats;
+
+	/* same timestamp as slot0, which is preferred */
+	test_blob_write(SLOT1_ADDR, &old_img);
+	zassert_equal(test_selected_slot(), 0U);
+
+	install_check(&lz4_pack);
+
+	test_flash_stats_get(&stats);
+	zassert_true(stats.erases > 2U);
+}
+
+ZTEST(install, test_watchdog_fed)
+{
+	install_check(&lz4_pack);
+
+	zassert_true(test_watchdog_feeds() >= NEW_IMG_SECTORS);
+}
+
+/* a newer image that fails validation is replaced, the booted one is kept */
+ZTEST(install, test_target_not_booted)
+{
+	test_blob_write(SLOT1_ADDR, &new_img);
+	zassert_ok(test_flash_corrupt(SLOT1_ADDR + new_img.len - 1U));
+	zassert_equal(test_selected_slot(), 0U);
+
+	install_check(&raw_pack);
+}
+
+static void install_reject_check(int err)
+{
+	zassert_equal(pb_install_firmware(), err);
+
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_NEW_FW_AVAILABLE));
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_NEW_FW_UPDATE_IN_PROGRESS));
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_NEW_FW_INSTALLED));
+	zassert_true(test_journal_cleared());
+}
+
+/* flash is left untouched when the package is corrupted */
+ZTEST(install, test_corrupt_package)
+{
+	struct test_flash_stats stats;
+
+	test_install_request(&lz4_pack, false);
+	zassert_ok(test_flash_corrupt(STAGING_ADDR + lz4_pack.len - 1U));
+	test_flash_stats_get(&stats);
+
+	install_reject_check(-EIO);
+
+	test_flash_stats_get(&stats);
+	zassert_equal(stats.writes, 0U);
+	zassert_equal(stats.erases, 0U);
+	zassert_equal(test_selected_slot(), 0U);
+}
+
+ZTEST(install, test_invalid_package)
+{
+	test_install_request(&raw_pack, false);
+	zassert_ok(test_flash_corrupt(STAGING_ADDR));
+
+	install_reject_check(-EINVAL);
+	zassert_equal(test_selected_slot(), 0U);
+}
+
+/* a delta only applies to the image it was made against */
+ZTEST(install, test_delta_wrong_source)
+{
+	test_blob_write(SLOT1_ADDR, &new_img);
+	zassert_equal(test_selected_slot(), 1U);
+
+	test_install_request(&delta_pack, false);
+	install_reject_check(-ENOENT);
+
+	zassert_true(test_blob_equal(SLOT0_ADDR, &old_img));
+	zassert_equal(test_selected_slot(), 1U);
+}
+
+static void install_prf_check(const struct test_blob *pack)
+{
+	test_install_request(pack, true);
+
+	zassert_ok(pb_install_prf());
+
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_NEW_PRF_AVAILABLE));
+	zassert_true(test_journal_cleared());
+	zassert_true(test_blob_equal(PRF_ADDR, &new_img));
+}
+
+ZTEST(install, test_prf_raw)
+{
+	install_prf_check(&raw_pack);
+}
+
+ZTEST(install, test_prf_lz4)
+{
+	install_prf_check(&lz4_pack);
+}
+
+ZTEST(install, test_prf_delta)
+{
+	struct firmware_header hdr;
+
+	test_install_request(&delta_pack, true);
+
+	zassert_equal(pb_install_prf(), -ENOTSUP);
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_NEW_PRF_AVAILABLE));
+	zassert_equal(pb_firmware_header_get(PRF_ADDR, new_img.len, &hdr), -EINVAL);
+}
+
+ZTEST_SUITE(install, NULL, NULL, install_before, NULL, NULL);
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_BOOT_INSTALL_INSTALL_TEST_H_
+#define TESTS_BOOT_INSTALL_INSTALL_TEST_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/sys/util.h>
+
+#define SLOT0_ADDR   DT_REG_ADDR(DT_CHOSEN(pb_slot0))
+#define SLOT1_ADDR   DT_REG_ADDR(DT_CHOSEN(pb_slot1))
+#define PRF_ADDR     DT_REG_ADDR(DT_CHOSEN(pb_prf))
+#define STAGING_ADDR DT_REG_ADDR(DT_CHOSEN(pb_staging))
+#define STAGING_SIZE DT_REG_SIZE(DT_CHOSEN(pb_staging))
+
+/* install journal, in the last erase sector (4 KiB on native_sim) */
+#define JOURNAL_ADDR (STAGING_ADDR + STAGING_SIZE - KB(4))
+
+/** Test file, generated at build time */
+struct test_blob {
+	const uint8_t *data;
+	size_t len;
+};
+
+/** Image in the active slot, source of the delta package */
+extern const struct test_blob old_img;
+/** Image in all packages */
+extern const struct test_blob new_img;
+
+extern const struct test_blob raw_pack;
+extern const struct test_blob lz4_pack;
+extern const struct test_blob delta_pack;
+
+/**
+ * @brief Start from a device running the old image from slot0.
+ *
+ * Flash areas used by the tests are erased, retained memory is cleared and
+ * boot bits are reset to their initialized state.
+ */
+void test_cold_boot(void);
+
+/**
+ * @brief Simulate a reset (e.g. after a power loss).
+ *
+ * Boot bits and the firmware module are initialized again.
+ */
+void test_reboot(void);
+
+/**
+ * @brief Write a test file to erased flash.
+ *
+ * @param address Flash offset.
+ * @param blob Test file.
+ */
+void test_blob_write(uint32_t address, const struct test_blob *blob);
+
+/**
+ * @brief Check if flash holds a test file.
+ *
+ * @param address Flash offset.
+ * @param blob Test file.
+ *
+ * @retval true if flash contents match
+ * @retval false otherwise
+ */
+bool test_blob_equal(uint32_t address, const struct test_blob *blob);
+
+/**
+ * @brief Stage a package and request its installation.
+ *
+ * @param pack Package.
+ * @param prf Install to the PRF partition instead of a firmware slot.
+ */
+void test_install_request(const struct test_blob *pack, bool prf);
+
+/**
+ * @brief Check if the install journal is cleared.
+ *
+ * @retval true if the journal sector is erased
+ * @retval false otherwise
+ */
+bool test_journal_cleared(void);
+
+/**
+ * @brief Get the selected firmware slot.
+ *
+ * @return Slot selected by pb_firmware_select().
+ */
+uint8_t test_selected_slot(void);
+
+/**
+ * @brief Get the number of watchdog feeds since the last call.
+ *
+ * @return Number of pb_watchdog_feed() calls.
+ */
+uint32_t test_watchdog_feeds(void);
+
+#endif /* TESTS_BOOT_INSTALL_INSTALL_TEST_H_ */
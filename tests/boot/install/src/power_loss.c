@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "firmware.h"
+#include "install.h"
+#include "install_test.h"
+#include "test_flash.h"
+
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include <pb/bootbit.h>
+
+static void power_loss_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	test_cold_boot();
+}
+
+static uint32_t install_ops(void)
+{
+	struct test_flash_stats stats;
+
+	test_flash_stats_get(&stats);
+
+	return stats.writes + stats.erases;
+}
+
+/*
+ * Lose power before each of the flash operations of an install in turn, then
+ * reboot: a bootable image must be left in either case, and the install must
+ * complete on the next boot, without redoing the operations already done.
+ */
+static void power_loss_check(const struct test_blob *pack)
+{
+	uint32_t ops;
+	uint32_t resume_ops;
+	int ret;
+
+	test_install_request(pack, false);
+	zassert_ok(pb_install_firmware());
+	ops = install_ops();
+
+	for (uint32_t cut = 0U; cut < ops; cut++) {
+		test_cold_boot();
+		test_install_request(pack, false);
+
+		zassert_true(test_flash_power_loss_run(pb_install_firmware, cut, &ret), "cut %u",
+			     cut);
+		zassert_equal(install_ops(), cut);
+
+		test_reboot();
+		zassert_ok(pb_firmware_select(), "cut %u", cut);
+
+		zassert_ok(pb_install_firmware(), "cut %u", cut);
+		resume_ops = install_ops();
+
+		zassert_true(pb_bootbit_tst(PB_BOOTBIT_NEW_FW_INSTALLED), "cut %u", cut);
+		zassert_false(pb_bootbit_tst(PB_BOOTBIT_NEW_FW_AVAILABLE), "cut %u", cut);
+		zassert_true(test_blob_equal(SLOT1_ADDR, &new_img), "cut %u", cut);
+		zassert_true(test_blob_equal(SLOT0_ADDR, &old_img), "cut %u", cut);
+		zassert_equal(test_selected_slot(), 1U, "cut %u", cut);
+
+		/* only a journal started but not yet written is restarted */
+		zassert_true(resume_ops <= (ops - cut + 1U), "cut %u: %u/%u ops", cut, resume_ops,
+			     ops);
+	}
+}
+
+ZTEST(power_loss, test_raw)
+{
+	power_loss_check(&raw_pack);
+}
+
+ZTEST(power_loss, test_lz4)
+{
+	power_loss_check(&lz4_pack);
+}
+
+ZTEST(power_loss, test_delta)
+{
+	power_loss_check(&delta_pack);
+}
+
+/* a rejected package is not retried on the next boot */
+ZTEST(power_loss, test_rejected_not_retried)
+{
+	test_install_request(&delta_pack, false);
+	test_blob_write(SLOT1_ADDR, &new_img);
+
+	zassert_true(pb_install_firmware() < 0);
+
+	test_reboot();
+	(void)install_ops();
+
+	zassert_false(pb_install_pending());
+	zassert_ok(pb_install_firmware());
+	zassert_equal(install_ops(), 0U);
+}
+
+ZTEST_SUITE(power_loss, NULL, NULL, power_loss_before, NULL, NULL);
@@ -0,0 +1,26 @@
+# Copyright (c) 2025 Core Devices LLC
+# SPDX-License-Identifier: Apache-2.0
+#
+# Common setup of pblboot test applications: bootloader sources are built
+# from boot/src, tests pick the ones they exercise with pb_test_boot_sources().
+# Applications must add this directory to DTS_ROOT before find_package(Zephyr),
+# for the test retained memory binding.
+
+set(PB_BOOT_SRC_DIR ${CMAKE_CURRENT_LIST_DIR}/../../boot/src)
+set(PB_TEST_COMMON_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+target_include_directories(app PRIVATE ${PB_BOOT_SRC_DIR} ${PB_TEST_COMMON_DIR}/include)
+
+target_sources_ifdef(CONFIG_FLASH app PRIVATE ${PB_TEST_COMMON_DIR}/src/test_image.c)
+target_sources_ifdef(CONFIG_RETAINED_MEM app PRIVATE ${PB_TEST_COMMON_DIR}/src/retained_mem_test.c)
+
+# there is nothing to jump to in tests
+if(NOT CONFIG_PB_FWJUMP)
+  target_sources(app PRIVATE ${PB_TEST_COMMON_DIR}/src/fwjump_stub.c)
+endif()
+
+function(pb_test_boot_sources)
+  foreach(src ${ARGN})
+    target_sources(app PRIVATE ${PB_BOOT_SRC_DIR}/${src})
+  endforeach()
+endfunction()
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file test_flash.h
+ * @brief Flash operation counting and power loss simulation for pblboot tests.
+ *
+ * Provided by the pb,test-flash controller, which must be the
+ * zephyr,flash-controller chosen node.
+ */
+
+#ifndef TESTS_COMMON_TEST_FLASH_H_
+#define TESTS_COMMON_TEST_FLASH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Flash operation counts */
+struct test_flash_stats {
+	/** Number of write operations */
+	uint32_t writes;
+	/** Number of erase operations */
+	uint32_t erases;
+};
+
+/**
+ * @brief Get the flash operations done since the last call.
+ *
+ * @param[out] stats Operation counts.
+ */
+void test_flash_stats_get(struct test_flash_stats *stats);
+
+/**
+ * @brief Run a function, losing power after a number of flash operations.
+ *
+ * Power is lost right before the write or erase following the first @p ops
+ * ones, which is not done, and the function does not return: all code that
+ * would have run afterwards is skipped, as on a real power loss. RAM state
+ * must then be initialized again, as after a reset.
+ *
+ * @param fn Function to run.
+ * @param ops Number of writes and erases done before power is lost.
+ * @param[out] ret Value returned by @p fn, if power was not lost.
+ *
+ * @retval true if power was lost
+ * @retval false if @p fn returned first
+ */
+bool test_flash_power_loss_run(int (*fn)(void), uint32_t ops, int *ret);
+
+#endif /* TESTS_COMMON_TEST_FLASH_H_ */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file test_image.h
+ * @brief Synthetic firmware images for pblboot tests.
+ *
+ * Images are laid out like the ones produced by scripts/pbimage.py: header at
+ * the start of the slot, digest table (version 2 headers) at
+ * @ref TEST_IMAGE_TABLE_OFFSET, and binary at @ref TEST_IMAGE_START_OFFSET.
+ * Binary contents are derived from a seed, so that an image can be checked
+ * or written again without being stored.
+ */
+
+#ifndef TESTS_COMMON_TEST_IMAGE_H_
+#define TESTS_COMMON_TEST_IMAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "firmware.h"
+
+/** Offset of the binary in test images */
+#define TEST_IMAGE_START_OFFSET 0x1000U
+
+/** Offset of the digest table in test images with a version 2 header */
+#define TEST_IMAGE_TABLE_OFFSET 0x100U
+
+/** Test image description */
+struct test_image {
+	/** Build timestamp */
+	uint64_t timestamp;
+	/** Binary length */
+	uint32_t length;
+	/** Digest table block size, 0 for a version 1 header */
+	uint32_t block_size;
+	/** Seed of the binary contents */
+	uint32_t seed;
+};
+
+/**
+ * @brief Fill a buffer with test image binary contents.
+ *
+ * @param buf Buffer.
+ * @param offset Offset of the buffer contents in the binary.
+ * @param len Length of the buffer.
+ * @param seed Seed of the binary contents.
+ */
+void test_image_fill(uint8_t *buf, uint32_t offset, size_t len, uint32_t seed);
+
+/**
+ * @brief Write a test image to flash.
+ *
+ * The area is erased first. The header is written last.
+ *
+ * @param address Slot address.
+ * @param img Image description.
+ * @param[out] hdr Header written, may be NULL.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int test_image_write(uint32_t address, const struct test_image *img, struct firmware_header *hdr);
+
+/**
+ * @brief Erase a flash area.
+ *
+ * @param address Area address.
+ * @param size Area size, rounded up to the erase block size.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int test_flash_erase(uint32_t address, uint32_t size);
+
+/**
+ * @brief Corrupt a byte in flash.
+ *
+ * The byte is inverted, the erase block holding it is rewritten.
+ *
+ * @param address Byte address.
+ *
+ * @retval 0 on success
+ * @retval -errno negative error code on failure
+ */
+int test_flash_corrupt(uint32_t address);
+
+#endif /* TESTS_COMMON_TEST_IMAGE_H_ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT pb_test_flash
+
+#include "test_flash.h"
+
+#include <setjmp.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/flash.h>
+
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1,
+	     "A single pb,test-flash controller is supported");
+
+struct flash_test_config {
+	const struct device *backend;
+};
+
+static struct test_flash_stats stats;
+
+/* power is lost once all allowed operations are done */
+static bool power_loss_armed;
+static uint32_t power_loss_ops;
+static jmp_buf power_loss_env;
+
+static void flash_test_power_check(void)
+{
+	if (!power_loss_armed) {
+		return;
+	}
+
+	if (power_loss_ops == 0U) {
+		power_loss_armed = false;
+		longjmp(power_loss_env, 1);
+	}
+
+	power_loss_ops--;
+}
+
+static int flash_test_read(const struct device *dev, off_t offset, void *data, size_t len)
+{
+	const struct flash_test_config *config = dev->config;
+
+	return flash_read(config->backend, offset, data, len);
+}
+
+static int flash_test_write(const struct device *dev, off_t offset, const void *data, size_t len)
+{
+	const struct flash_test_config *config = dev->config;
+
+	flash_test_power_check();
+	stats.writes++;
+
+	return flash_write(config->backend, offset, data, len);
+}
+
+static int flash_test_erase(const struct device *dev, off_t offset, size_t size)
+{
+	const struct flash_test_config *config = dev->config;
+
+	flash_test_power_check();
+	stats.erases++;
+
+	return flash_erase(config->backend, offset, size);
+}
+
+static const struct flash_parameters *flash_test_get_parameters(const struct device *dev)
+{
+	const struct flash_test_config *config = dev->config;
+
+	return flash_get_parameters(config->backend);
+}
+
+static int flash_test_get_size(const struct device *dev, uint64_t *size)
+{
+	const struct flash_test_config *config = dev->config;
+
+	return flash_get_size(config->backend, size);
+}
+
+#ifdef CONFIG_FLASH_PAGE_LAYOUT
+static void flash_test_page_layout(const struct device *dev,
+				   const struct flash_pages_layout **layout, size_t *layout_size)
+{
+	const struct flash_test_config *config = dev->config;
+
+	DEVICE_API_GET(flash, config->backend)->page_layout(config->backend, layout, layout_size);
+}
+#endif
+
+static DEVICE_API(flash, flash_test_api) = {
+	.read = flash_test_read,
+	.write = flash_test_write,
+	.erase = flash_test_erase,
+	.get_parameters = flash_test_get_parameters,
+	.get_size = flash_test_get_size,
+#ifdef CONFIG_FLASH_PAGE_LAYOUT
+	.page_layout = flash_test_page_layout,
+#endif
+};
+
+void test_flash_stats_get(struct test_flash_stats *out)
+{
+	*out = stats;
+	stats = (struct test_flash_stats){0};
+}
+
+bool test_flash_power_loss_run(int (*fn)(void), uint32_t ops, int *ret)
+{
+	power_loss_ops = ops;
+	power_loss_armed = true;
+
+	if (setjmp(power_loss_env) != 0) {
+		return true;
+	}
+
+	*ret = fn();
+	power_loss_armed = false;
+
+	return false;
+}
+
+#define FLASH_TEST_DEFINE(inst)                                                                    \
+	static const struct flash_test_config flash_test_config##inst = {                          \
+		.backend = DEVICE_DT_GET(DT_INST_PHANDLE(inst, backend)),                          \
+	};                                                                                         \
+                                                                                                   \
+	DEVICE_DT_INST_DEFINE(inst, NULL, NULL, NULL, &flash_test_config##inst, POST_KERNEL,       \
+			      CONFIG_FLASH_INIT_PRIORITY, &flash_test_api);
+
+DT_INST_FOREACH_STATUS_OKAY(FLASH_TEST_DEFINE)
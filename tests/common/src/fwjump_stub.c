@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/toolchain.h>
+
+#include <pb/fwjump.h>
+
+/* tests never jump, reaching this is a failure */
+void FUNC_NORETURN pb_fwjump(uintptr_t addr)
+{
+	ARG_UNUSED(addr);
+
+	k_panic();
+	CODE_UNREACHABLE;
+}
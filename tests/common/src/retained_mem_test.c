@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT pb_test_retained_mem
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/retained_mem.h>
+
+struct retained_mem_test_config {
+	uint8_t *buf;
+	size_t size;
+};
+
+static bool retained_mem_test_in_range(const struct device *dev, off_t offset, size_t size)
+{
+	const struct retained_mem_test_config *config = dev->config;
+
+	return (offset >= 0) && ((size_t)offset <= config->size) &&
+	       (size <= (config->size - (size_t)offset));
+}
+
+static ssize_t retained_mem_test_size(const struct device *dev)
+{
+	const struct retained_mem_test_config *config = dev->config;
+
+	return (ssize_t)config->size;
+}
+
+static int retained_mem_test_read(const struct device *dev, off_t offset, uint8_t *buffer,
+				  size_t size)
+{
+	const struct retained_mem_test_config *config = dev->config;
+
+	if (!retained_mem_test_in_range(dev, offset, size)) {
+		return -EINVAL;
+	}
+
+	memcpy(buffer, &config->buf[offset], size);
+
+	return 0;
+}
+
+static int retained_mem_test_write(const struct device *dev, off_t offset, const uint8_t *buffer,
+				   size_t size)
+{
+	const struct retained_mem_test_config *config = dev->config;
+
+	if (!retained_mem_test_in_range(dev, offset, size)) {
+		return -EINVAL;
+	}
+
+	memcpy(&config->buf[offset], buffer, size);
+
+	return 0;
+}
+
+static int retained_mem_test_clear(const struct device *dev)
+{
+	const struct retained_mem_test_config *config = dev->config;
+
+	memset(config->buf, 0, config->size);
+
+	return 0;
+}
+
+static DEVICE_API(retained_mem, retained_mem_test_api) = {
+	.size = retained_mem_test_size,
+	.read = retained_mem_test_read,
+	.write = retained_mem_test_write,
+	.clear = retained_mem_test_clear,
+};
+
+#define RETAINED_MEM_TEST_DEFINE(inst)                                                             \
+	static uint8_t retained_mem_test_buf##inst[DT_INST_PROP(inst, size)];                      \
+                                                                                                   \
+	static const struct retained_mem_test_config retained_mem_test_config##inst = {            \
+		.buf = retained_mem_test_buf##inst,                                                \
+		.size = DT_INST_PROP(inst, size),                                                  \
+	};                                                                                         \
+                                                                                                   \
+	DEVICE_DT_INST_DEFINE(inst, NULL, NULL, NULL, &retained_mem_test_config##inst,             \
+			      PRE_KERNEL_1, CONFIG_RETAINED_MEM_INIT_PRIORITY,                     \
+			      &retained_mem_test_api);
+
+DT_INST_FOREACH_STATUS_OKAY(RETAINED_MEM_TEST_DEFINE)
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_image.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/sys/util.h>
+
+#include <pb/crc.h>
+
+#define CHUNK_SIZE      256U
+#define ERASE_SIZE_MAX  4096U
+#define TABLE_LEN_MAX   ((TEST_IMAGE_START_OFFSET - TEST_IMAGE_TABLE_OFFSET) / sizeof(uint32_t))
+
+static const struct device *flash = DEVICE_DT_GET(DT_CHOSEN(zephyr_flash_controller));
+
+static uint8_t chunk[CHUNK_SIZE];
+static uint8_t block[ERASE_SIZE_MAX];
+static uint32_t table[TABLE_LEN_MAX];
+
+void test_image_fill(uint8_t *buf, uint32_t offset, size_t len, uint32_t seed)
+{
+	for (size_t i = 0U; i < len; i++) {
+		/* multiplicative hash of the offset, every byte value shows up */
+		buf[i] = (uint8_t)(((offset + i + seed) * 0x9e3779b1U) >> 24);
+	}
+}
+
+int test_flash_erase(uint32_t address, uint32_t size)
+{
+	struct flash_pages_info info;
+	int ret;
+
+	ret = flash_get_page_info_by_offs(flash, address, &info);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return flash_erase(flash, address, ROUND_UP(size, info.size));
+}
+
+int test_flash_corrupt(uint32_t address)
+{
+	struct flash_pages_info info;
+	int ret;
+
+	ret = flash_get_page_info_by_offs(flash, address, &info);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (info.size > sizeof(block)) {
+		return -ENOMEM;
+	}
+
+	ret = flash_read(flash, info.start_offset, block, info.size);
+	if (ret < 0) {
+		return ret;
+	}
+
+	block[address - info.start_offset] ^= 0xFFU;
+
+	ret = flash_erase(flash, info.start_offset, info.size);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return flash_write(flash, info.start_offset, block, info.size);
+}
+
+int test_image_write(uint32_t address, const struct test_image *img, struct firmware_header *hdr)
+{
+	struct firmware_header h = {
+		.magic = PBLBOOT_MAGIC,
+		.header_length = PBLBOOT_HEADER_V1_LENGTH,
+		.timestamp = img->timestamp,
+		.start_offset = TEST_IMAGE_START_OFFSET,
+		.length = img->length,
+	};
+	uint32_t blocks = 0U;
+	uint32_t crc = 0U;
+	uint32_t block_crc = 0U;
+	int ret;
+
+	if (img->block_size != 0U) {
+		blocks = DIV_ROUND_UP(img->length, img->block_size);
+		if ((blocks > ARRAY_SIZE(table)) || ((img->block_size % CHUNK_SIZE) != 0U)) {
+			return -EINVAL;
+		}
+	}
+
+	ret = test_flash_erase(address, TEST_IMAGE_START_OFFSET + img->length);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (uint32_t pos = 0U; pos < img->length; pos += CHUNK_SIZE) {
+		size_t len = MIN(CHUNK_SIZE, img->length - pos);
+
+		test_image_fill(chunk, pos, len, img->seed);
+
+		crc = pb_crc32_ieee_update(crc, chunk, len);
+		if (img->block_size != 0U) {
+			uint32_t end = pos + len;
+
+			block_crc = pb_crc32_ieee_update(block_crc, chunk, len);
+			if (((end % img->block_size) == 0U) || (end == img->length)) {
+				table[pos / img->block_size] = block_crc;
+				block_crc = 0U;
+			}
+		}
+
+		ret = flash_write(flash, address + TEST_IMAGE_START_OFFSET + pos, chunk, len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	h.crc = crc;
+
+	if (img->block_size != 0U) {
+		h.header_length = PBLBOOT_HEADER_V2_LENGTH;
+		h.block_size = img->block_size;
+		h.table_offset = TEST_IMAGE_TABLE_OFFSET;
+		h.table_crc = pb_crc32_ieee(table, blocks * sizeof(uint32_t));
+
+		ret = flash_write(flash, address + TEST_IMAGE_TABLE_OFFSET, table,
+				  blocks * sizeof(uint32_t));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	/* header last, as the installer does */
+	ret = flash_write(flash, address, &h, h.header_length);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (hdr != NULL) {
+		*hdr = h;
+	}
+
+	return 0;
+}
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/init.h>
+#include <zephyr/irq.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/printk-hooks.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include <pb/cobs.h>
+#include <pb/crc.h>
+#include <pb/drivers/console/pulse_uart_console.h>
+
+#define FRAME_DELIMITER 0x55U
+#define MSG_HDR_LEN     35U
+#define MSG_CRC_LEN     4U
+#define MSG_MAX_LEN     256U
+#define MSG_TYPE        (IS_ENABLED(CONFIG_PULSE_UART_CONSOLE_BATCH) ? 3U : 1U)
+
+/* batched lines also take a length prefix */
+#define LINE_MAX_LEN                                                                               \
+	(MSG_MAX_LEN - MSG_HDR_LEN - (IS_ENABLED(CONFIG_PULSE_UART_CONSOLE_BATCH) ? 1U : 0U))
+
+/* large enough for the output of any test, framing included */
+#define CAPTURE_LEN 8192U
+
+/* number of lines written at once, more than the TX buffer holds */
+#define BURST_LINES 64U
+
+static const struct device *const uart = DEVICE_DT_GET(DT_CHOSEN(zephyr_console));
+
+/* Pulse transport push, Pulse protocol logging */
+static const uint8_t msg_hdr[] = {0x50U, 0x21U, 0x00U, 0x03U};
+
+static printk_hook_fn_t host_out;
+static printk_hook_fn_t console_out;
+
+static uint8_t capture[CAPTURE_LEN];
+static size_t capture_len;
+
+/* the emulated UART sends data as soon as it gets it */
+static void uart_tx_data_ready(const struct device *dev, size_t size, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	size = MIN(size, sizeof(capture) - capture_len);
+	capture_len += uart_emul_get_tx_data(dev, &capture[capture_len], size);
+}
+
+/* host console output, set up before the Pulse console */
+static int test_host_out_get(void)
+{
+	host_out = __printk_get_hook();
+
+	return 0;
+}
+
+SYS_INIT(test_host_out_get, PRE_KERNEL_2, 0);
+
+/*
+ * Test results keep going to the host console: the Pulse console only gets
+ * what tests write with console_write().
+ */
+static int test_console_out_get(void)
+{
+	console_out = __printk_get_hook();
+	__printk_hook_install(host_out);
+
+	/* drop output sent before (e.g. boot banner) */
+	pulse_uart_console_flush();
+	(void)uart_emul_flush_tx_data(uart);
+	uart_emul_callback_tx_data_ready_set(uart, uart_tx_data_ready, NULL);
+
+	return 0;
+}
+
+SYS_INIT(test_console_out_get, APPLICATION, 0);
+
+static void console_write(const char *str)
+{
+	while (*str != '\0') {
+		(void)console_out(*str++);
+	}
+}
+
+/* check a decoded frame, and append the lines it carries to text */
+static size_t frame_text_get(const uint8_t *msg, size_t len, char *text)
+{
+	size_t text_len = 0U;
+
+	zassert_true(len >= (MSG_HDR_LEN + MSG_CRC_LEN), "short frame (%zu bytes)", len);
+	len -= MSG_CRC_LEN;
+
+	zassert_equal(sys_get_le32(&msg[len]), pb_crc32_ieee(msg, len), "bad CRC");
+	zassert_mem_equal(msg, msg_hdr, sizeof(msg_hdr));
+	zassert_equal(sys_get_be16(&msg[4]), len - 2U);
+	zassert_equal(msg[6], MSG_TYPE);
+
+	if (IS_ENABLED(CONFIG_PULSE_UART_CONSOLE_BATCH)) {
+		/* length prefixed records */
+		for (size_t i = MSG_HDR_LEN; i < len; i += msg[i] + 1U) {
+			zassert_true((i + msg[i] + 1U) <= len, "record overflows frame");
+			memcpy(&text[text_len], &msg[i + 1U], msg[i]);
+			text_len += msg[i];
+			text[text_len++] = '\n';
+		}
+	} else {
+		memcpy(text, &msg[MSG_HDR_LEN], len - MSG_HDR_LEN);
+		text_len = len - MSG_HDR_LEN;
+		text[text_len++] = '\n';
+	}
+
+	return text_len;
+}
+
+/* decode and check all frames sent so far, and get the lines they carry */
+static const char *console_text_get(void)
+{
+	static uint8_t frame[CAPTURE_LEN];
+	static char text[CAPTURE_LEN];
+	size_t text_len = 0U;
+	size_t i = 0U;
+
+	zassert_true(capture_len < sizeof(capture), "capture buffer full");
+
+	while (i < capture_len) {
+		size_t len = 0U;
+		int ret;
+
+		zassert_equal(capture[i++], FRAME_DELIMITER, "frame start expected at %zu", i);
+
+		/* frame delimiter is swapped with zero, which COBS never outputs */
+		while ((i < capture_len) && (capture[i] != FRAME_DELIMITER)) {
+			frame[len++] = (capture[i] == 0U) ? FRAME_DELIMITER : capture[i];
+			i++;
+		}
+
+		zassert_true(i < capture_len, "frame end expected");
+		i++;
+
+		ret = pb_cobs_decode(frame, frame, len);
+		zassert_true(ret >= 0, "invalid COBS data");
+
+		text_len += frame_text_get(frame, (size_t)ret, &text[text_len]);
+	}
+
+	text[text_len] = '\0';
+
+	return text;
+}
+
+static void console_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* drop output left over by a failed test */
+	pulse_uart_console_flush();
+	capture_len = 0U;
+}
+
+ZTEST(console, test_lines)
+{
+	console_write("hello\r\n\nworld\n");
+	pulse_uart_console_flush();
+
+	zassert_str_equal(console_text_get(), "hello\n\nworld\n");
+}
+
+/* the frame delimiter may show up anywhere in messages */
+ZTEST(console, test_delimiter)
+{
+	console_write("U\nUUUU UUUU\n");
+	pulse_uart_console_flush();
+
+	zassert_str_equal(console_text_get(), "U\nUUUU UUUU\n");
+}
+
+/* a line without its newline (e.g. on panic) is sent on flush */
+ZTEST(console, test_partial_line)
+{
+	console_write("complete\npartial");
+	pulse_uart_console_flush();
+
+	zassert_str_equal(console_text_get(), "complete\npartial\n");
+}
+
+/* lines longer than a message are truncated */
+ZTEST(console, test_long_line)
+{
+	const char *text;
+
+	for (uint32_t i = 0U; i < (MSG_MAX_LEN + 64U); i++) {
+		(void)console_out('U');
+	}
+	(void)console_out('\n');
+	pulse_uart_console_flush();
+
+	text = console_text_get();
+	zassert_equal(strlen(text), LINE_MAX_LEN + 1U);
+	zassert_equal(strspn(text, "U"), LINE_MAX_LEN);
+}
+
+/* zeros in lines are kept (COBS blocks end before the line does) */
+ZTEST(console, test_zero)
+{
+	static const char expected[] = {'a', '\0', '\0', 'b', '\n', 'c', '\n'};
+	const char *text;
+
+	console_write("a");
+	(void)console_out('\0');
+	(void)console_out('\0');
+	console_write("b\nc\n");
+	pulse_uart_console_flush();
+
+	text = console_text_get();
+	zassert_mem_equal(text, expected, sizeof(expected));
+	zassert_equal(text[sizeof(expected)], '\0');
+}
+
+/* lines are sent without being flushed */
+ZTEST(console, test_sent)
+{
+	if (IS_ENABLED(CONFIG_PULSE_UART_CONSOLE_BATCH)) {
+		ztest_test_skip();
+	}
+
+	console_write("hello\n");
+	k_sleep(K_MSEC(10));
+
+	zassert_str_equal(console_text_get(), "hello\n");
+}
+
+/*
+ * With the scheduler locked, the TX buffer is not drained and overflows: it
+ * is then sent synchronously, and lines must still come out in order.
+ */
+ZTEST(console, test_burst)
+{
+	static char expected[CAPTURE_LEN];
+	size_t expected_len = 0U;
+
+	k_sched_lock();
+
+	for (uint32_t i = 0U; i < BURST_LINES; i++) {
+		char line[64];
+
+		snprintk(line, sizeof(line), "line %02u 0123456789abcdef0123456789abcdef\n", i);
+		console_write(line);
+
+		strcpy(&expected[expected_len], line);
+		expected_len += strlen(line);
+	}
+
+	k_sched_unlock();
+
+	pulse_uart_console_flush();
+
+	zassert_str_equal(console_text_get(), expected);
+}
+
+#ifdef CONFIG_PULSE_UART_CONSOLE_ASYNC
+/* output is buffered, flush waits a bounded time before sending it */
+ZTEST(console, test_async_flush)
+{
+	uint32_t start;
+	uint32_t elapsed_us;
+
+	/* keep the UART interrupt handler from running */
+	k_sched_lock();
+
+	console_write("hello\n");
+	zassert_equal(capture_len, 0U);
+
+	start = k_cycle_get_32();
+	pulse_uart_console_flush();
+	elapsed_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	k_sched_unlock();
+
+	zassert_true(elapsed_us >= CONFIG_PULSE_UART_CONSOLE_FLUSH_TIMEOUT_US, "%u us",
+		     elapsed_us);
+	zassert_str_equal(console_text_get(), "hello\n");
+}
+
+/* with interrupts locked, buffered output is sent first, then polling is used */
+ZTEST(console, test_async_irq_locked)
+{
+	unsigned int key;
+
+	/* batched lines are only sent with the batch */
+	if (IS_ENABLED(CONFIG_PULSE_UART_CONSOLE_BATCH)) {
+		ztest_test_skip();
+	}
+
+	k_sched_lock();
+
+	console_write("first\n");
+	zassert_equal(capture_len, 0U);
+
+	key = irq_lock();
+	console_write("second\n");
+	irq_unlock(key);
+
+	/* all sent without the interrupt handler */
+	zassert_str_equal(console_text_get(), "first\nsecond\n");
+
+	k_sched_unlock();
+}
+#endif /* CONFIG_PULSE_UART_CONSOLE_ASYNC */
+
+ZTEST_SUITE(console, NULL, NULL, console_before, NULL, NULL);
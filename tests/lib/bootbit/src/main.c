@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include <pb/bootbit.h>
+#include <pb/bootbit_backend.h>
+
+/* storage value written behind the library's back, to detect stores */
+#define FOREIGN_BITS (BIT(PB_BOOTBIT_INITIALIZED) | BIT(31))
+
+static void bootbit_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	pb_bootbit_backend_store(BIT(PB_BOOTBIT_INITIALIZED));
+	pb_bootbit_init();
+}
+
+ZTEST(bootbit, test_init_uninitialized)
+{
+	pb_bootbit_backend_store(BIT(PB_BOOTBIT_FORCE_PRF));
+	pb_bootbit_init();
+
+	/* garbage is dropped and the initialized word stored at once */
+	zassert_equal(pb_bootbit_backend_load(), BIT(PB_BOOTBIT_INITIALIZED));
+	zassert_true(pb_bootbit_tst(PB_BOOTBIT_INITIALIZED));
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_FORCE_PRF));
+}
+
+ZTEST(bootbit, test_init_loads_storage)
+{
+	pb_bootbit_backend_store(BIT(PB_BOOTBIT_INITIALIZED) | BIT(PB_BOOTBIT_FORCE_PRF));
+	pb_bootbit_init();
+
+	zassert_true(pb_bootbit_tst(PB_BOOTBIT_FORCE_PRF));
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_FW_STABLE));
+}
+
+ZTEST(bootbit, test_shadow_until_commit)
+{
+	pb_bootbit_set(PB_BOOTBIT_FW_STABLE);
+	pb_bootbit_set(PB_BOOTBIT_NEW_FW_INSTALLED);
+	pb_bootbit_clr(PB_BOOTBIT_NEW_FW_INSTALLED);
+
+	zassert_true(pb_bootbit_tst(PB_BOOTBIT_FW_STABLE));
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_NEW_FW_INSTALLED));
+	zassert_equal(pb_bootbit_backend_load(), BIT(PB_BOOTBIT_INITIALIZED));
+
+	pb_bootbit_commit();
+
+	zassert_equal(pb_bootbit_backend_load(),
+		      BIT(PB_BOOTBIT_INITIALIZED) | BIT(PB_BOOTBIT_FW_STABLE));
+}
+
+ZTEST(bootbit, test_reset_before_commit)
+{
+	pb_bootbit_set(PB_BOOTBIT_FW_STABLE);
+
+	/* a reset before the commit loses the changes as a whole */
+	pb_bootbit_init();
+
+	zassert_false(pb_bootbit_tst(PB_BOOTBIT_FW_STABLE));
+}
+
+ZTEST(bootbit, test_commit_unchanged)
+{
+	pb_bootbit_set(PB_BOOTBIT_FW_STABLE);
+	pb_bootbit_clr(PB_BOOTBIT_FW_STABLE);
+
+	pb_bootbit_backend_store(FOREIGN_BITS);
+	pb_bootbit_commit();
+
+	/* nothing changed since the last store, storage is not written */
+	zassert_equal(pb_bootbit_backend_load(), FOREIGN_BITS);
+}
+
+ZTEST(bootbit, test_fw_fail_cnt)
+{
+	for (uint8_t cnt = 0U; cnt <= PB_BOOTBIT_FW_FAIL_CNT_MAX; cnt++) {
+		pb_bootbit_fw_fail_cnt_set(cnt);
+		zassert_equal(pb_bootbit_fw_fail_cnt_get(), cnt);
+	}
+
+	pb_bootbit_commit();
+	pb_bootbit_init();
+
+	zassert_equal(pb_bootbit_fw_fail_cnt_get(), PB_BOOTBIT_FW_FAIL_CNT_MAX);
+}
+
+ZTEST(bootbit, test_prf_fail_cnt)
+{
+	for (uint8_t cnt = 0U; cnt <= PB_BOOTBIT_PRF_FAIL_CNT_MAX; cnt++) {
+		pb_bootbit_prf_fail_cnt_set(cnt);
+		zassert_equal(pb_bootbit_prf_fail_cnt_get(), cnt);
+	}
+
+	zassert_equal(pb_bootbit_fw_fail_cnt_get(), 0U);
+}
+
+ZTEST(bootbit, test_reset_loop_cnt)
+{
+	for (uint8_t cnt = 0U; cnt <= PB_BOOTBIT_RESET_LOOP_CNT_MAX; cnt++) {
+		pb_bootbit_reset_loop_cnt_set(cnt);
+		zassert_equal(pb_bootbit_reset_loop_cnt_get(), cnt);
+	}
+
+	pb_bootbit_reset_loop_cnt_set(0U);
+	zassert_equal(pb_bootbit_reset_loop_cnt_get(), 0U);
+}
+
+ZTEST(bootbit, test_tst_and_clr)
+{
+	zassert_false(pb_bootbit_prf_starting_tst_and_clr());
+	pb_bootbit_prf_starting_set();
+	zassert_true(pb_bootbit_prf_starting_tst_and_clr());
+	zassert_false(pb_bootbit_prf_starting_tst_and_clr());
+
+	pb_bootbit_set(PB_BOOTBIT_SOFTWARE_FAILURE_OCCURRED);
+	zassert_true(pb_bootbit_fw_fail_tst_and_clr());
+	zassert_false(pb_bootbit_fw_fail_tst_and_clr());
+
+	pb_bootbit_set(PB_BOOTBIT_FW_STABLE);
+	zassert_true(pb_bootbit_fw_stable_tst_and_clr());
+	zassert_false(pb_bootbit_fw_stable_tst_and_clr());
+
+	pb_bootbit_set(PB_BOOTBIT_FORCE_PRF);
+	zassert_true(pb_bootbit_force_prf_tst_and_clr());
+	zassert_false(pb_bootbit_force_prf_tst_and_clr());
+}
+
+/* a boot sequence's worth of updates, committed in a single store */
+ZTEST(bootbit, test_sequence_single_commit)
+{
+	pb_bootbit_backend_store(BIT(PB_BOOTBIT_INITIALIZED) | BIT(PB_BOOTBIT_FW_STABLE) |
+				 BIT(PB_BOOTBIT_SOFTWARE_FAILURE_OCCURRED));
+	pb_bootbit_init();
+
+	pb_bootbit_reset_loop_cnt_set(pb_bootbit_reset_loop_cnt_get() + 1U);
+	zassert_true(pb_bootbit_fw_stable_tst_and_clr());
+	zassert_true(pb_bootbit_fw_fail_tst_and_clr());
+	pb_bootbit_fw_fail_cnt_set(pb_bootbit_fw_fail_cnt_get() + 1U);
+
+	zassert_equal(pb_bootbit_backend_load(),
+		      BIT(PB_BOOTBIT_INITIALIZED) | BIT(PB_BOOTBIT_FW_STABLE) |
+			      BIT(PB_BOOTBIT_SOFTWARE_FAILURE_OCCURRED));
+
+	pb_bootbit_commit();
+
+	zassert_equal(pb_bootbit_backend_load(),
+		      BIT(PB_BOOTBIT_INITIALIZED) | BIT(PB_BOOTBIT_RESET_LOOP_DETECT_ONE) |
+			      BIT(PB_BOOTBIT_FW_START_FAIL_STRIKE_ONE));
+}
+
+ZTEST_SUITE(bootbit, NULL, NULL, bootbit_before, NULL, NULL);
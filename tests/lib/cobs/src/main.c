@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include <pb/cobs.h>
+
+#define DATA_LEN_MAX 1024U
+
+struct cobs_vector {
+	const uint8_t *dec;
+	size_t dec_len;
+	const uint8_t *enc;
+	size_t enc_len;
+};
+
+#define COBS_VECTOR(_dec, _enc)                                                                    \
+	{                                                                                          \
+		.dec = (_dec), .dec_len = sizeof(_dec), .enc = (_enc), .enc_len = sizeof(_enc),    \
+	}
+
+static const uint8_t dec_zero[] = {0x00};
+static const uint8_t enc_zero[] = {0x01, 0x01};
+static const uint8_t dec_zeros[] = {0x00, 0x00};
+static const uint8_t enc_zeros[] = {0x01, 0x01, 0x01};
+static const uint8_t dec_mixed[] = {0x00, 0x11, 0x00};
+static const uint8_t enc_mixed[] = {0x01, 0x02, 0x11, 0x01};
+static const uint8_t dec_inner[] = {0x11, 0x22, 0x00, 0x33};
+static const uint8_t enc_inner[] = {0x03, 0x11, 0x22, 0x02, 0x33};
+static const uint8_t dec_nozero[] = {0x11, 0x22, 0x33, 0x44};
+static const uint8_t enc_nozero[] = {0x05, 0x11, 0x22, 0x33, 0x44};
+static const uint8_t dec_trailing[] = {0x11, 0x00, 0x00, 0x00};
+static const uint8_t enc_trailing[] = {0x02, 0x11, 0x01, 0x01, 0x01};
+
+static const struct cobs_vector vectors[] = {
+	COBS_VECTOR(dec_zero, enc_zero),
+	COBS_VECTOR(dec_zeros, enc_zeros),
+	COBS_VECTOR(dec_mixed, enc_mixed),
+	COBS_VECTOR(dec_inner, enc_inner),
+	COBS_VECTOR(dec_nozero, enc_nozero),
+	COBS_VECTOR(dec_trailing, enc_trailing),
+};
+
+static uint8_t src[DATA_LEN_MAX];
+static uint8_t enc[PB_COBS_MAX_ENC_SIZE(DATA_LEN_MAX)];
+static uint8_t enc_ref[PB_COBS_MAX_ENC_SIZE(DATA_LEN_MAX)];
+static uint8_t dec[PB_COBS_MAX_ENC_SIZE(DATA_LEN_MAX)];
+
+static uint32_t rand_state;
+
+/* deterministic pseudo-random numbers, so failures can be reproduced */
+static uint32_t test_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+
+	return rand_state >> 16;
+}
+
+/* fill with non-zero bytes, one in @p zero_every being zero */
+static void fill(uint8_t *buf, size_t len, uint32_t zero_every)
+{
+	for (size_t i = 0U; i < len; i++) {
+		if ((zero_every != 0U) && ((test_rand() % zero_every) == 0U)) {
+			buf[i] = 0U;
+		} else {
+			buf[i] = (uint8_t)((test_rand() % 255U) + 1U);
+		}
+	}
+}
+
+/* fill with increasing non-zero bytes, wrapping around to 1 after 0xFF */
+static void fill_seq(uint8_t *buf, size_t len, uint8_t first)
+{
+	uint8_t val = first;
+
+	for (size_t i = 0U; i < len; i++) {
+		buf[i] = val;
+		val = (val == 0xFFU) ? 1U : (val + 1U);
+	}
+}
+
+static void check_roundtrip(const uint8_t *data, size_t len)
+{
+	size_t enc_len;
+	int dec_len;
+
+	enc_len = pb_cobs_encode(enc, data, len);
+	zassert_true(enc_len <= MAX(PB_COBS_MAX_ENC_SIZE(len), 1U), "len %zu", len);
+	zassert_is_null(memchr(enc, 0, enc_len), "len %zu", len);
+
+	dec_len = pb_cobs_decode(dec, enc, enc_len);
+	zassert_equal(dec_len, (int)len, "len %zu", len);
+	zassert_mem_equal(dec, data, len, "len %zu", len);
+}
+
+static void cobs_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	rand_state = 0x12345678U;
+}
+
+ZTEST(cobs, test_encode_vectors)
+{
+	ARRAY_FOR_EACH(vectors, i) {
+		size_t enc_len = pb_cobs_encode(enc, vectors[i].dec, vectors[i].dec_len);
+
+		zassert_equal(enc_len, vectors[i].enc_len, "vector %zu", i);
+		zassert_mem_equal(enc, vectors[i].enc, enc_len, "vector %zu", i);
+	}
+}
+
+ZTEST(cobs, test_decode_vectors)
+{
+	ARRAY_FOR_EACH(vectors, i) {
+		int dec_len = pb_cobs_decode(dec, vectors[i].enc, vectors[i].enc_len);
+
+		zassert_equal(dec_len, (int)vectors[i].dec_len, "vector %zu", i);
+		zassert_mem_equal(dec, vectors[i].dec, dec_len, "vector %zu", i);
+	}
+}
+
+ZTEST(cobs, test_empty)
+{
+	zassert_equal(pb_cobs_encode(enc, src, 0U), 1U);
+	zassert_equal(enc[0], 0x01U);
+
+	zassert_equal(pb_cobs_decode(dec, enc, 1U), 0);
+	zassert_equal(pb_cobs_decode(dec, enc, 0U), 0);
+}
+
+/* 254 non-zero bytes: a single full block, without a trailing code */
+ZTEST(cobs, test_254_nozero)
+{
+	fill_seq(src, 254U, 0x01U);
+
+	zassert_equal(pb_cobs_encode(enc, src, 254U), 255U);
+	zassert_equal(enc[0], 0xFFU);
+	zassert_mem_equal(&enc[1], src, 254U);
+
+	check_roundtrip(src, 254U);
+}
+
+/* 255 non-zero bytes: a full block, then a block with the last byte */
+ZTEST(cobs, test_255_nozero)
+{
+	fill_seq(src, 255U, 0x01U);
+
+	zassert_equal(pb_cobs_encode(enc, src, 255U), 257U);
+	zassert_equal(enc[0], 0xFFU);
+	zassert_mem_equal(&enc[1], src, 254U);
+	zassert_equal(enc[255], 0x02U);
+	zassert_equal(enc[256], 0xFFU);
+
+	check_roundtrip(src, 255U);
+}
+
+/* a zero then 254 non-zero bytes */
+ZTEST(cobs, test_255_leading_zero)
+{
+	src[0] = 0x00U;
+	fill_seq(&src[1], 254U, 0x01U);
+
+	zassert_equal(pb_cobs_encode(enc, src, 255U), 256U);
+	zassert_equal(enc[0], 0x01U);
+	zassert_equal(enc[1], 0xFFU);
+	zassert_mem_equal(&enc[2], &src[1], 254U);
+
+	check_roundtrip(src, 255U);
+}
+
+/* 254 non-zero bytes then a zero */
+ZTEST(cobs, test_255_trailing_zero)
+{
+	fill_seq(src, 254U, 0x02U);
+	src[254] = 0x00U;
+
+	zassert_equal(pb_cobs_encode(enc, src, 255U), 257U);
+	zassert_equal(enc[0], 0xFFU);
+	zassert_mem_equal(&enc[1], src, 254U);
+	zassert_equal(enc[255], 0x01U);
+	zassert_equal(enc[256], 0x01U);
+
+	check_roundtrip(src, 255U);
+}
+
+/* 253 non-zero bytes, a zero, then a non-zero byte */
+ZTEST(cobs, test_255_inner_zero)
+{
+	fill_seq(src, 253U, 0x03U);
+	src[253] = 0x00U;
+	src[254] = 0x01U;
+
+	zassert_equal(pb_cobs_encode(enc, src, 255U), 256U);
+	zassert_equal(enc[0], 0xFEU);
+	zassert_mem_equal(&enc[1], src, 253U);
+	zassert_equal(enc[254], 0x02U);
+	zassert_equal(enc[255], 0x01U);
+
+	check_roundtrip(src, 255U);
+}
+
+ZTEST(cobs, test_long_nozero_runs)
+{
+	/* lengths around multiples of the block size */
+	for (size_t len = 250U; len < DATA_LEN_MAX; len += 127U) {
+		for (size_t i = 0U; i < 9U; i++) {
+			fill(src, len + i - 4U, 0U);
+			check_roundtrip(src, len + i - 4U);
+		}
+	}
+}
+
+ZTEST(cobs, test_roundtrip_random)
+{
+	static const uint32_t zero_every[] = {0U, 1U, 2U, 16U, 256U, 1000U};
+
+	ARRAY_FOR_EACH(zero_every, i) {
+		for (size_t len = 0U; len <= DATA_LEN_MAX; len += 31U) {
+			fill(src, len, zero_every[i]);
+			check_roundtrip(src, len);
+		}
+	}
+}
+
+ZTEST(cobs, test_encode_inplace)
+{
+	static const size_t lens[] = {0U, 1U, 253U, 254U, 255U, 508U, 509U, DATA_LEN_MAX};
+
+	ARRAY_FOR_EACH(lens, i) {
+		size_t enc_len;
+
+		fill(src, lens[i], (i % 2U) == 0U ? 0U : 64U);
+		enc_len = pb_cobs_encode(enc_ref, src, lens[i]);
+
+		memcpy(&enc[PB_COBS_OVERHEAD(lens[i])], src, lens[i]);
+		zassert_equal(pb_cobs_encode_inplace(enc, lens[i]), enc_len, "len %zu", lens[i]);
+		zassert_mem_equal(enc, enc_ref, enc_len, "len %zu", lens[i]);
+	}
+}
+
+ZTEST(cobs, test_decode_inplace)
+{
+	size_t enc_len;
+	int dec_len;
+
+	fill(src, DATA_LEN_MAX, 16U);
+	enc_len = pb_cobs_encode(enc, src, DATA_LEN_MAX);
+
+	dec_len = pb_cobs_decode(enc, enc, enc_len);
+	zassert_equal(dec_len, (int)DATA_LEN_MAX);
+	zassert_mem_equal(enc, src, DATA_LEN_MAX);
+}
+
+ZTEST(cobs, test_decode_invalid)
+{
+	/* zero code */
+	static const uint8_t zero_code[] = {0x02, 0x11, 0x00, 0x22};
+	/* run past the end */
+	static const uint8_t truncated[] = {0x05, 0x11, 0x22};
+	/* zero within a run */
+	static const uint8_t inner_zero[] = {0x04, 0x11, 0x00, 0x22};
+
+	zassert_equal(pb_cobs_decode(dec, zero_code, sizeof(zero_code)), -EINVAL);
+	zassert_equal(pb_cobs_decode(dec, truncated, sizeof(truncated)), -EINVAL);
+	zassert_equal(pb_cobs_decode(dec, inner_zero, sizeof(inner_zero)), -EINVAL);
+}
+
+struct stream_out {
+	uint8_t *buf;
+	size_t len;
+};
+
+static void stream_out(const uint8_t *data, size_t len, void *user_data)
+{
+	struct stream_out *out = user_data;
+
+	memcpy(&out->buf[out->len], data, len);
+	out->len += len;
+}
+
+ZTEST(cobs, test_stream)
+{
+	struct pb_cobs_enc stream;
+
+	for (size_t n = 0U; n < 64U; n++) {
+		struct stream_out out = {.buf = enc};
+		size_t len = (n < 8U) ? (250U + n) : (test_rand() % DATA_LEN_MAX);
+		size_t enc_len;
+		size_t pos = 0U;
+
+		fill(src, len, (n % 3U) == 0U ? 0U : 100U);
+		enc_len = pb_cobs_encode(enc_ref, src, len);
+
+		/* random pieces, including empty ones */
+		pb_cobs_enc_init(&stream, stream_out, &out);
+		while (pos < len) {
+			size_t piece = test_rand() % 300U;
+
+			piece = MIN(piece, len - pos);
+
+			pb_cobs_enc_update(&stream, &src[pos], piece);
+			pos += piece;
+		}
+		pb_cobs_enc_finish(&stream);
+
+		zassert_equal(out.len, enc_len, "len %zu", len);
+		zassert_mem_equal(enc, enc_ref, enc_len, "len %zu", len);
+	}
+}
+
+ZTEST_SUITE(cobs, NULL, NULL, cobs_before, NULL, NULL);
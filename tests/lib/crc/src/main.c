@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Core Devices LLC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include <pb/crc.h>
+
+#define DATA_LEN 1024U
+
+/* extra bytes so that every alignment can be tested */
+static uint8_t data[DATA_LEN + 8U] __aligned(8);
+
+static void *crc_setup(void)
+{
+	uint32_t state = 0x12345678U;
+
+	for (size_t i = 0U; i < sizeof(data); i++) {
+		state = state * 1103515245U + 12345U;
+		data[i] = (uint8_t)(state >> 16);
+	}
+
+	return NULL;
+}
+
+ZTEST(crc, test_check_value)
+{
+	static const char check[] = "123456789";
+
+	zassert_equal(pb_crc32_ieee(check, strlen(check)), 0xCBF43926U);
+}
+
+ZTEST(crc, test_empty)
+{
+	zassert_equal(pb_crc32_ieee(data, 0U), 0U);
+	zassert_equal(pb_crc32_ieee_update(0xDEADBEEFU, data, 0U), 0xDEADBEEFU);
+}
+
+ZTEST(crc, test_same_as_zephyr)
+{
+	static const size_t lens[] = {1U, 3U, 4U, 7U, 8U, 9U, 63U, 64U, 65U, DATA_LEN};
+
+	/* lengths around the word and slice sizes, at every alignment */
+	for (size_t align = 0U; align < 8U; align++) {
+		ARRAY_FOR_EACH(lens, i) {
+			zassert_equal(pb_crc32_ieee(&data[align], lens[i]),
+				      crc32_ieee(&data[align], lens[i]), "align %zu, len %zu",
+				      align, lens[i]);
+		}
+	}
+}
+
+ZTEST(crc, test_update)
+{
+	uint32_t expected = crc32_ieee(data, DATA_LEN);
+
+	for (size_t split = 0U; split <= 16U; split++) {
+		uint32_t crc;
+
+		crc = pb_crc32_ieee_update(0U, data, split);
+		crc = pb_crc32_ieee_update(crc, &data[split], DATA_LEN - split);
+
+		zassert_equal(crc, expected, "split %zu", split);
+	}
+}
+
+ZTEST(crc, test_combine)
+{
+	uint32_t expected = pb_crc32_ieee(data, DATA_LEN);
+
+	for (size_t split = 0U; split <= DATA_LEN; split += 100U) {
+		uint32_t crc1 = pb_crc32_ieee(data, split);
+		uint32_t crc2 = pb_crc32_ieee(&data[split], DATA_LEN - split);
+		uint32_t op = pb_crc32_ieee_combine_gen(DATA_LEN - split);
+
+		zassert_equal(pb_crc32_ieee_combine(crc1, crc2, DATA_LEN - split), expected,
+			      "split %zu", split);
+		zassert_equal(pb_crc32_ieee_combine_op(crc1, crc2, op), expected, "split %zu",
+			      split);
+	}
+}
+
+ZTEST_SUITE(crc, NULL, crc_setup, NULL, NULL, NULL);